@@ -0,0 +1,316 @@
+#include "../src/server/protocol.h"
+#include "../src/common/latency_histogram.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * @brief Load generator for the query server
+ *
+ * Opens --connections connections, each on its own thread, and keeps
+ * --depth requests in flight per connection (one write of depth frames,
+ * then depth responses) for --duration-s seconds. Ops are drawn from
+ * --mix over the instances the server reports. Latency is measured per
+ * request from the write to the arrival of its response, so it includes
+ * queueing on the client socket and in the server's batch.
+ */
+
+using namespace protocol;
+using Clock = std::chrono::steady_clock;
+
+struct LoadOptions {
+    std::string socket_path = "/tmp/lbsn_query.sock";
+    int connections = 4;
+    int depth = 1;
+    double duration_s = 10.0;
+    int k = 10;
+    int exact_k = 3;
+    bool no_cache = false;
+    int mix[kQueryOps] = {60, 10, 30};      // Weights of Greedy, Exact, ClosestPair
+    unsigned seed = 42;
+    std::string csv_path = "experiments/data/load_generator.csv";
+};
+
+const char* kOpNames[kQueryOps] = {"greedy", "exact", "closest_pair"};
+
+LoadOptions options;
+
+struct ServerInfo {
+    std::vector<uint32_t> users;        // Per coverage instance
+    std::vector<uint32_t> points;       // Per point set
+};
+
+int connect_server() {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (options.socket_path.size() >= sizeof(addr.sun_path)) return -1;
+    std::strcpy(addr.sun_path, options.socket_path.c_str());
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Send one request and read its response payload; false on I/O error or non-Ok status
+ */
+bool call(int fd, Op op, std::vector<char>& payload) {
+    RequestFrame request{1, static_cast<uint8_t>(op), 0, 0, 0, 0};
+    ResponseHeader header;
+    if (!write_full(fd, &request, sizeof(request)) || !read_full(fd, &header, sizeof(header))) return false;
+    payload.resize(header.payload_bytes);
+    if (!read_full(fd, payload.data(), payload.size())) return false;
+    return header.status == static_cast<uint8_t>(Status::Ok);
+}
+
+bool read_info(int fd, ServerInfo& info) {
+    std::vector<char> payload;
+    if (!call(fd, Op::Info, payload)) return false;
+    size_t offset = 0;
+    uint32_t coverage = 0, point_sets = 0;
+    if (!extract(payload, offset, coverage) || !extract(payload, offset, point_sets)) return false;
+    info.users.resize(coverage);
+    info.points.resize(point_sets);
+    for (auto& v : info.users) if (!extract(payload, offset, v)) return false;
+    for (auto& v : info.points) if (!extract(payload, offset, v)) return false;
+    return true;
+}
+
+/**
+ * @brief Per-connection loop: depth requests per write until the deadline
+ */
+void run_connection(int c, const ServerInfo& info, Clock::time_point deadline,
+                    LatencyHistogram* histograms, LatencyHistogram& all,
+                    std::atomic<long long>* errors, std::atomic<bool>& failed) {
+    int fd = connect_server();
+    if (fd < 0) {
+        failed = true;
+        return;
+    }
+
+    // Exact only on instances within the brute force limit
+    std::vector<uint32_t> exact_targets;
+    for (uint32_t i = 0; i < info.users.size(); ++i) {
+        if (info.users[i] <= 20) exact_targets.push_back(i);
+    }
+    int weights[kQueryOps] = {info.users.empty() ? 0 : options.mix[0],
+                              exact_targets.empty() ? 0 : options.mix[1],
+                              info.points.empty() ? 0 : options.mix[2]};
+    std::mt19937 rng(options.seed + c);
+    std::discrete_distribution<int> pick_op(weights, weights + kQueryOps);
+
+    std::vector<RequestFrame> frames(options.depth);
+    std::vector<char> payload;
+    uint32_t next_id = 0;
+
+    while (Clock::now() < deadline) {
+        for (auto& f : frames) {
+            Op op = static_cast<Op>(pick_op(rng) + 1);
+            uint32_t instance;
+            if (op == Op::Greedy) {
+                instance = std::uniform_int_distribution<uint32_t>(0, info.users.size() - 1)(rng);
+            } else if (op == Op::Exact) {
+                instance = exact_targets[std::uniform_int_distribution<size_t>(0, exact_targets.size() - 1)(rng)];
+            } else {
+                instance = std::uniform_int_distribution<uint32_t>(0, info.points.size() - 1)(rng);
+            }
+            f = RequestFrame{next_id++, static_cast<uint8_t>(op), static_cast<uint8_t>(options.no_cache ? kNoCache : 0),
+                             0, instance, op == Op::Exact ? options.exact_k : options.k};
+        }
+
+        Clock::time_point sent = Clock::now();
+        if (!write_full(fd, frames.data(), frames.size() * sizeof(RequestFrame))) {
+            failed = true;
+            break;
+        }
+        for (int i = 0; i < options.depth; ++i) {
+            ResponseHeader header;
+            if (!read_full(fd, &header, sizeof(header))) {
+                failed = true;
+                break;
+            }
+            payload.resize(header.payload_bytes);
+            if (!read_full(fd, payload.data(), payload.size())) {
+                failed = true;
+                break;
+            }
+            long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - sent).count();
+            if (header.op >= 1 && header.op <= kQueryOps) {
+                histograms[header.op - 1].record(ns);
+                if (header.status != static_cast<uint8_t>(Status::Ok)) errors[header.op - 1]++;
+            }
+            all.record(ns);
+        }
+        if (failed) break;
+    }
+    ::close(fd);
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --socket PATH             Server socket (default /tmp/lbsn_query.sock)\n"
+              << "  --connections N           Concurrent connections, one thread each (default 4)\n"
+              << "  --depth N                 Requests in flight per connection (default 1)\n"
+              << "  --duration-s X            Length of the run (default 10)\n"
+              << "  --mix g,e,c               Weights of greedy, exact, closest_pair (default 60,10,30)\n"
+              << "  --k N                     k of greedy queries (default 10)\n"
+              << "  --exact-k N               k of exact queries (default 3)\n"
+              << "  --no-cache                Ask the server to bypass its result caches\n"
+              << "  --seed N                  Seed of the request stream (default 42)\n"
+              << "  --csv PATH                Output file (default experiments/data/load_generator.csv)\n";
+}
+
+bool parse_args(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(arg + " needs a value");
+            return argv[++i];
+        };
+
+        try {
+            if (arg == "--socket") {
+                options.socket_path = value();
+            } else if (arg == "--connections") {
+                options.connections = std::max(1, std::stoi(value()));
+            } else if (arg == "--depth") {
+                options.depth = std::max(1, std::stoi(value()));
+            } else if (arg == "--duration-s") {
+                options.duration_s = std::stod(value());
+            } else if (arg == "--mix") {
+                std::stringstream ss(value());
+                std::string weight;
+                for (int op = 0; op < kQueryOps; ++op) {
+                    if (!std::getline(ss, weight, ',')) throw std::invalid_argument("--mix needs 3 weights");
+                    options.mix[op] = std::max(0, std::stoi(weight));
+                }
+            } else if (arg == "--k") {
+                options.k = std::max(0, std::stoi(value()));
+            } else if (arg == "--exact-k") {
+                options.exact_k = std::max(0, std::stoi(value()));
+            } else if (arg == "--no-cache") {
+                options.no_cache = true;
+            } else if (arg == "--seed") {
+                options.seed = std::stoul(value());
+            } else if (arg == "--csv") {
+                options.csv_path = value();
+            } else if (arg == "--help" || arg == "-h") {
+                print_usage(argv[0]);
+                std::exit(0);
+            } else {
+                throw std::invalid_argument("unknown option " + arg);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (!parse_args(argc, argv)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int fd = connect_server();
+    ServerInfo info;
+    if (fd < 0 || !read_info(fd, info)) {
+        std::cerr << "Error: no query server on " << options.socket_path << " (start one with make server)\n";
+        return 1;
+    }
+    bool exact_possible = std::any_of(info.users.begin(), info.users.end(), [](uint32_t n) { return n <= 20; });
+    if ((info.users.empty() || options.mix[0] == 0) && (!exact_possible || options.mix[1] == 0) &&
+        (info.points.empty() || options.mix[2] == 0)) {
+        std::cerr << "Error: no loaded instance matches the --mix (exact needs an instance of <= 20 users)\n";
+        return 1;
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "Query Server Load Generator\n";
+    std::cout << "========================================\n\n";
+    std::cout << "  " << info.users.size() << " coverage instances, " << info.points.size() << " point sets; "
+              << options.connections << " connections x depth " << options.depth << " for "
+              << options.duration_s << " s" << (options.no_cache ? ", cache bypassed" : "") << "\n\n";
+
+    LatencyHistogram histograms[kQueryOps];
+    LatencyHistogram all;
+    std::atomic<long long> errors[kQueryOps] = {};
+    std::atomic<bool> failed{false};
+
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.duration_s));
+    std::vector<std::thread> threads;
+    for (int c = 0; c < options.connections; ++c) {
+        threads.emplace_back(run_connection, c, std::cref(info), deadline, histograms, std::ref(all),
+                             errors, std::ref(failed));
+    }
+    for (auto& t : threads) t.join();
+    double wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+    if (failed) std::cerr << "  Warning: a connection failed before the end of the run\n";
+
+    // Server-side latency (cumulative since the server started)
+    uint64_t server_stats[kQueryOps][4] = {};
+    std::vector<char> payload;
+    if (call(fd, Op::Stats, payload)) {
+        size_t offset = 0;
+        for (auto& op : server_stats) {
+            for (auto& v : op) extract(payload, offset, v);
+        }
+    }
+    ::close(fd);
+
+    system("mkdir -p experiments/data");
+    std::ofstream out(options.csv_path);
+    out << "op,connections,depth,no_cache,duration_s,requests,errors,qps,mean_us,p50_us,p90_us,p99_us,"
+        << "p999_us,max_us,server_p50_us,server_p99_us\n";
+
+    std::cout << "  " << std::left << std::setw(14) << "op" << std::right << std::setw(10) << "requests"
+              << std::setw(10) << "qps" << std::setw(10) << "p50 us" << std::setw(10) << "p99 us"
+              << std::setw(10) << "max us" << std::setw(12) << "server p99" << "\n";
+    auto report = [&](const std::string& name, const LatencyHistogram& h, double server_p50, double server_p99,
+                      long long errs) {
+        double qps = h.count() / wall_s;
+        out << name << "," << options.connections << "," << options.depth << "," << options.no_cache << ","
+            << wall_s << "," << h.count() << "," << errs << "," << qps << "," << h.mean_ns() / 1e3 << ","
+            << h.percentile_ns(0.5) / 1e3 << "," << h.percentile_ns(0.9) / 1e3 << ","
+            << h.percentile_ns(0.99) / 1e3 << "," << h.percentile_ns(0.999) / 1e3 << "," << h.max_ns() / 1e3
+            << "," << server_p50 << "," << server_p99 << "\n";
+        std::cout << "  " << std::left << std::setw(14) << name << std::right << std::setw(10) << h.count()
+                  << std::fixed << std::setprecision(1) << std::setw(10) << qps << std::setw(10)
+                  << h.percentile_ns(0.5) / 1e3 << std::setw(10) << h.percentile_ns(0.99) / 1e3 << std::setw(10)
+                  << h.max_ns() / 1e3 << std::setw(12) << server_p99 << "\n" << std::defaultfloat;
+    };
+    long long total_errors = 0;
+    for (int op = 0; op < kQueryOps; ++op) {
+        total_errors += errors[op];
+        if (histograms[op].count() == 0) continue;
+        report(kOpNames[op], histograms[op], server_stats[op][1] / 1e3, server_stats[op][2] / 1e3, errors[op]);
+    }
+    report("all", all, -1, -1, total_errors);
+    if (total_errors) std::cerr << "  Warning: " << total_errors << " requests returned an error status\n";
+
+    out.close();
+    std::cout << "\n  Results saved to " << options.csv_path << "\n";
+    return 0;
+}
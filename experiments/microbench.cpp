@@ -0,0 +1,294 @@
+#include "../src/greedy/max_coverage.h"
+#include "../src/divide_conquer/closest_pair.h"
+#include "../src/divide_conquer/radix_sort.h"
+#include "../src/common/data_generator.h"
+#include "../src/common/microbench.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <stdexcept>
+
+/**
+ * @brief Micro-benchmarks of the building blocks behind the experiments
+ *
+ * Each kernel runs on controlled inputs:
+ * - cache: working set of about 32 KB (L1/L2 resident)
+ * - dram: working set of --dram-mb MB (default 64, larger than most LLCs)
+ * - sorted / random: input order or access pattern, where it matters
+ *
+ * Reported per kernel and input: median and minimum ns/op, nominal bytes
+ * of working set touched per op, and the resulting GB/s.
+ */
+
+struct MicrobenchOptions {
+    MicrobenchConfig config;
+    std::string filter;                                     // Substring of "kernel/input"
+    std::size_t dram_bytes = 64u << 20;
+    std::string csv_path = "experiments/data/microbench.csv";
+};
+
+MicrobenchOptions options;
+std::vector<MicrobenchResult> results;
+
+const std::size_t kCacheBytes = 32u << 10;
+
+bool selected(const std::string& kernel, const std::string& input) {
+    return options.filter.empty() || (kernel + "/" + input).find(options.filter) != std::string::npos;
+}
+
+void report(const MicrobenchResult& r) {
+    std::cout << "  " << std::left << std::setw(18) << r.kernel << std::setw(16) << r.input
+              << std::right << std::fixed << std::setprecision(2) << std::setw(10) << r.ns_per_op
+              << std::setw(10) << r.min_ns_per_op << std::setw(10) << r.bytes_per_op
+              << std::setw(10) << r.gb_per_s() << std::setw(8) << r.samples << "\n"
+              << std::defaultfloat;
+    results.push_back(r);
+}
+
+std::vector<Point> random_points(std::size_t n, double side, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<> coord(0.0, side);
+    std::vector<Point> points;
+    points.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) points.emplace_back(coord(gen), coord(gen), (int)i);
+    return points;
+}
+
+/**
+ * @brief distance() over consecutive pairs, in memory order or through a
+ *        random permutation (one cache miss per op once out of cache)
+ */
+void bench_distance() {
+    for (auto [level, bytes] : {std::pair<const char*, std::size_t>{"cache", kCacheBytes},
+                                {"dram", options.dram_bytes}}) {
+        std::size_t n = bytes / sizeof(Point);
+        auto points = random_points(n, 1000.0, 1);
+
+        std::string input = std::string(level) + "/sorted";
+        if (selected("distance", input)) {
+            report(measure_kernel(options.config, "distance", input, n - 1, sizeof(Point), [&] {
+                double sum = 0;
+                for (std::size_t i = 0; i + 1 < n; ++i) sum += distance(points[i], points[i + 1]);
+                do_not_optimize(sum);
+            }));
+        }
+
+        input = std::string(level) + "/random";
+        if (selected("distance", input)) {
+            std::vector<int> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            std::shuffle(order.begin(), order.end(), std::mt19937(2));
+            report(measure_kernel(options.config, "distance", input, n - 1,
+                                  sizeof(Point) + sizeof(int), [&] {
+                double sum = 0;
+                for (std::size_t i = 0; i + 1 < n; ++i) {
+                    sum += distance(points[order[i]], points[order[i + 1]]);
+                }
+                do_not_optimize(sum);
+            }));
+        }
+    }
+}
+
+/**
+ * @brief marginal_gain() of 1000 users against a covered set that fits in
+ *        cache or not (about half the lookups hit); one op = one lookup
+ */
+void bench_marginal_gain() {
+    // Bucket pointer + node (int, next pointer) per covered location
+    const double bytes_per_entry = sizeof(void*) + 16;
+
+    for (auto [level, bytes] : {std::pair<const char*, std::size_t>{"cache", kCacheBytes},
+                                {"dram", options.dram_bytes}}) {
+        std::string input = std::string(level) + "/random";
+        if (!selected("marginal_gain", input)) continue;
+
+        int covered_size = std::max(64, (int)(bytes / bytes_per_entry));
+        std::unordered_set<int> covered;
+        covered.reserve(covered_size);
+        for (int loc = 0; loc < covered_size; ++loc) covered.insert(2 * loc);
+
+        DataGenerator gen(3);
+        auto users = gen.generate_uniform(1000, 2 * covered_size, 50);
+        long long lookups = 0;
+        for (const auto& u : users) lookups += u.num_locations();
+
+        report(measure_kernel(options.config, "marginal_gain", input, lookups, bytes_per_entry, [&] {
+            long long total = 0;
+            for (const auto& u : users) total += marginal_gain(u, covered);
+            do_not_optimize(total);
+        }));
+    }
+}
+
+/**
+ * @brief compute_coverage() of a selection whose union fits in cache or
+ *        not; one op = one location inserted into the result set
+ */
+void bench_compute_coverage() {
+    const double bytes_per_entry = sizeof(void*) + 16;
+
+    for (auto [level, bytes] : {std::pair<const char*, std::size_t>{"cache", kCacheBytes},
+                                {"dram", options.dram_bytes}}) {
+        std::string input = std::string(level) + "/random";
+        if (!selected("compute_coverage", input)) continue;
+
+        // About 50 distinct locations per user, mostly disjoint
+        int n_users = std::max(1, (int)(bytes / bytes_per_entry / 50));
+        DataGenerator gen(4);
+        auto users = gen.generate_uniform(n_users, n_users * 500, 50);
+        std::vector<int> selection(n_users);
+        std::iota(selection.begin(), selection.end(), 0);
+
+        long long inserts = 0;
+        for (const auto& u : users) inserts += u.num_locations();
+
+        report(measure_kernel(options.config, "compute_coverage", input, inserts, bytes_per_entry, [&] {
+            do_not_optimize(compute_coverage(users, selection));
+        }));
+    }
+}
+
+/**
+ * @brief find_strip_closest() on a y-sorted strip of width 2 * delta with
+ *        about four points per delta of height; one op = one strip point
+ */
+void bench_strip_scan() {
+    for (auto [level, bytes] : {std::pair<const char*, std::size_t>{"cache", kCacheBytes},
+                                {"dram", options.dram_bytes}}) {
+        std::string input = std::string(level) + "/sorted";
+        if (!selected("strip_scan", input)) continue;
+
+        std::size_t m = bytes / sizeof(Point);
+        const double delta = 1.0;
+        std::mt19937 gen(5);
+        std::uniform_real_distribution<> xs(-delta, delta), ys(0.0, m * delta / 4);
+        std::vector<Point> strip;
+        strip.reserve(m);
+        for (std::size_t i = 0; i < m; ++i) strip.emplace_back(xs(gen), ys(gen), (int)i);
+        std::sort(strip.begin(), strip.end(), compare_y);
+
+        report(measure_kernel(options.config, "strip_scan", input, m, sizeof(Point), [&] {
+            long long comparisons = 0;
+            do_not_optimize(find_strip_closest(strip, delta, comparisons).distance);
+        }));
+    }
+}
+
+/**
+ * @brief Coordinate sorts (radix_sort_points vs std::sort with compare_x)
+ *        on random and already sorted input; one op = one point
+ */
+void bench_sorts() {
+    for (auto [level, bytes] : {std::pair<const char*, std::size_t>{"cache", kCacheBytes},
+                                {"dram", options.dram_bytes}}) {
+        std::size_t n = bytes / sizeof(Point);
+        auto random_input = random_points(n, 1000.0, 6);
+        auto sorted_input = random_input;
+        std::sort(sorted_input.begin(), sorted_input.end(), compare_x);
+
+        for (auto [order, source] : {std::pair<const char*, const std::vector<Point>*>{"random", &random_input},
+                                     {"sorted", &sorted_input}}) {
+            std::string input = std::string(level) + "/" + order;
+            std::vector<Point> work;
+            auto reset = [&] { work = *source; };     // Untimed copy before every call
+
+            if (selected("radix_sort_x", input)) {
+                report(measure_kernel(options.config, "radix_sort_x", input, n, sizeof(Point), reset, [&] {
+                    radix_sort_points(work, SortAxis::X);
+                }));
+            }
+            if (selected("std_sort_x", input)) {
+                report(measure_kernel(options.config, "std_sort_x", input, n, sizeof(Point), reset, [&] {
+                    std::sort(work.begin(), work.end(), compare_x);
+                }));
+            }
+        }
+    }
+}
+
+void write_csv(const std::string& path) {
+    std::ofstream out(path);
+    out << "kernel,input,ops_per_call,bytes_per_op,ns_per_op,min_ns_per_op,ci95_ns,gb_per_s,samples,calls\n";
+    for (const auto& r : results) {
+        out << r.kernel << "," << r.input << "," << r.ops_per_call << "," << r.bytes_per_op << ","
+            << r.ns_per_op << "," << r.min_ns_per_op << "," << r.ci95_ns << "," << r.gb_per_s() << ","
+            << r.samples << "," << r.calls << "\n";
+    }
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --filter TEXT             Only kernels whose \"kernel/input\" contains TEXT\n"
+              << "  --samples N               Samples per kernel (default 11)\n"
+              << "  --min-sample-ms X         Minimum duration of one sample (default 20)\n"
+              << "  --dram-mb N               Working set of the dram inputs (default 64)\n"
+              << "  --csv PATH                Output file (default experiments/data/microbench.csv)\n";
+}
+
+bool parse_args(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(arg + " needs a value");
+            return argv[++i];
+        };
+
+        try {
+            if (arg == "--filter") {
+                options.filter = value();
+            } else if (arg == "--samples") {
+                options.config.samples = std::max(1, std::stoi(value()));
+            } else if (arg == "--min-sample-ms") {
+                options.config.min_sample_ms = std::stod(value());
+            } else if (arg == "--dram-mb") {
+                options.dram_bytes = (std::size_t)std::max(1, std::stoi(value())) << 20;
+            } else if (arg == "--csv") {
+                options.csv_path = value();
+            } else if (arg == "--help" || arg == "-h") {
+                print_usage(argv[0]);
+                std::exit(0);
+            } else {
+                throw std::invalid_argument("unknown option " + arg);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (!parse_args(argc, argv)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "Kernel Micro-benchmarks\n";
+    std::cout << "========================================\n\n";
+    std::cout << "  cache inputs: " << (kCacheBytes >> 10) << " KB, dram inputs: "
+              << (options.dram_bytes >> 20) << " MB\n\n";
+    std::cout << "  " << std::left << std::setw(18) << "kernel" << std::setw(16) << "input"
+              << std::right << std::setw(10) << "ns/op" << std::setw(10) << "min"
+              << std::setw(10) << "bytes/op" << std::setw(10) << "GB/s" << std::setw(8) << "samples"
+              << "\n";
+
+    bench_distance();
+    bench_marginal_gain();
+    bench_compute_coverage();
+    bench_strip_scan();
+    bench_sorts();
+
+    system("mkdir -p experiments/data");
+    write_csv(options.csv_path);
+    std::cout << "\n  Results saved to " << options.csv_path << "\n";
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include "../src/server/query_server.h"
+#include "../src/divide_conquer/external_closest_pair.h"
+#include "../src/common/data_generator.h"
+#include "../src/common/timer.h"
+#include <csignal>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <stdexcept>
+
+/**
+ * @brief Resident query server: load instances once, answer queries over a Unix socket
+ *
+ * Generates (or reads) the coverage instances and point sets at startup,
+ * then serves greedy, exact and closest-pair queries until SIGINT or
+ * SIGTERM, and prints the server-side latency per op on the way out.
+ * Drive it with experiments/load_generator (make loadgen).
+ */
+
+struct ServerOptions {
+    ServerConfig config;
+    std::vector<int> coverage_sizes = {20, 1000, 5000};        // Users per coverage instance
+    std::vector<int> point_sizes = {100000, 1000000};
+    std::vector<std::string> point_files;
+    int seed = 42;
+};
+
+ServerOptions options;
+QueryServer* running_server = nullptr;
+
+void handle_signal(int) {
+    if (running_server) running_server->stop();
+}
+
+std::vector<Point> random_points(int n, double side, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<> coord(0.0, side);
+    std::vector<Point> points;
+    points.reserve(n);
+    for (int i = 0; i < n; ++i) points.emplace_back(coord(gen), coord(gen), i);
+    return points;
+}
+
+std::vector<int> parse_sizes(const std::string& list) {
+    std::vector<int> sizes;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) sizes.push_back((int)std::stod(item));
+    }
+    return sizes;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --socket PATH             Unix socket path (default /tmp/lbsn_query.sock)\n"
+              << "  --workers N               Solver threads (default 0 = hardware threads)\n"
+              << "  --max-batch N             Requests executed per batch at most (default 64)\n"
+              << "  --cache N                 Entries per result cache (default 64)\n"
+              << "  --coverage n1,n2,...      Users per coverage instance (default 20,1000,5000)\n"
+              << "  --points n1,n2,...        Points per generated point set (default 100000,1000000)\n"
+              << "  --points-file PATH        Also load a point set written by write_points_file (repeatable)\n"
+              << "  --seed N                  Seed of the generated instances (default 42)\n";
+}
+
+bool parse_args(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(arg + " needs a value");
+            return argv[++i];
+        };
+
+        try {
+            if (arg == "--socket") {
+                options.config.socket_path = value();
+            } else if (arg == "--workers") {
+                options.config.workers = std::max(0, std::stoi(value()));
+            } else if (arg == "--max-batch") {
+                options.config.max_batch = std::max(1, std::stoi(value()));
+            } else if (arg == "--cache") {
+                options.config.cache_capacity = std::max(1, std::stoi(value()));
+            } else if (arg == "--coverage") {
+                options.coverage_sizes = parse_sizes(value());
+            } else if (arg == "--points") {
+                options.point_sizes = parse_sizes(value());
+            } else if (arg == "--points-file") {
+                options.point_files.push_back(value());
+            } else if (arg == "--seed") {
+                options.seed = std::stoi(value());
+            } else if (arg == "--help" || arg == "-h") {
+                print_usage(argv[0]);
+                std::exit(0);
+            } else {
+                throw std::invalid_argument("unknown option " + arg);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (!parse_args(argc, argv)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "Query Server\n";
+    std::cout << "========================================\n\n";
+
+    QueryServer server(options.config);
+    Timer load;
+    load.start();
+    for (size_t i = 0; i < options.coverage_sizes.size(); ++i) {
+        DataGenerator gen(options.seed + (int)i);
+        int id = server.add_coverage_instance(gen.generate_uniform(options.coverage_sizes[i], 5000, 50));
+        std::cout << "  coverage instance " << id << ": " << options.coverage_sizes[i] << " users\n";
+    }
+    for (size_t i = 0; i < options.point_sizes.size(); ++i) {
+        int id = server.add_point_set(random_points(options.point_sizes[i], 1000.0, options.seed + (unsigned)i));
+        std::cout << "  point set " << id << ": " << options.point_sizes[i] << " points\n";
+    }
+    for (const std::string& path : options.point_files) {
+        std::vector<Point> points;
+        if (!read_points_file(path, points)) {
+            std::cerr << "Error: cannot read " << path << "\n";
+            return 1;
+        }
+        int id = server.add_point_set(std::move(points));
+        std::cout << "  point set " << id << ": " << path << "\n";
+    }
+    std::cout << "  Loaded in " << std::fixed << std::setprecision(1) << load.elapsed_ms() << " ms\n\n"
+              << std::defaultfloat;
+
+    running_server = &server;
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::cout << "  Listening on " << options.config.socket_path << " (Ctrl-C to stop)\n" << std::flush;
+    if (!server.run()) {
+        std::cerr << "Error: cannot listen on " << options.config.socket_path << "\n";
+        return 1;
+    }
+
+    std::cout << "\n  Server-side latency (receipt to response, queueing included):\n";
+    const char* names[] = {"greedy", "exact", "closest_pair"};
+    const protocol::Op ops[] = {protocol::Op::Greedy, protocol::Op::Exact, protocol::Op::ClosestPair};
+    for (int i = 0; i < protocol::kQueryOps; ++i) {
+        const LatencyHistogram& h = server.latency(ops[i]);
+        std::cout << "  " << std::left << std::setw(14) << names[i] << std::right << std::setw(10) << h.count()
+                  << " queries, p50 " << std::fixed << std::setprecision(1) << h.percentile_ns(0.5) / 1e3
+                  << " us, p99 " << h.percentile_ns(0.99) / 1e3 << " us, max " << h.max_ns() / 1e3 << " us\n"
+                  << std::defaultfloat;
+    }
+    CacheStats greedy_cache = server.coverage_cache_stats(), cp_cache = server.closest_pair_cache_stats();
+    std::cout << "  Cache hits / misses: greedy " << greedy_cache.hits << " / " << greedy_cache.misses
+              << ", closest_pair " << cp_cache.hits << " / " << cp_cache.misses << "\n";
+    return 0;
+}
@@ -1,13 +1,45 @@
 #include "../src/greedy/max_coverage.h"
+#include "../src/greedy/batch_coverage.h"
+#include "../src/greedy/anytime_coverage.h"
+#include "../src/greedy/coverage_cache.h"
 #include "../src/divide_conquer/closest_pair.h"
+#include "../src/divide_conquer/batch_closest_pair.h"
+#include "../src/divide_conquer/closest_pair_cache.h"
+#include "../src/divide_conquer/compact_closest_pair.h"
+#include "../src/divide_conquer/external_closest_pair.h"
+#include "../src/divide_conquer/closest_pair_nd.h"
+#include "../src/divide_conquer/geo_closest_pair.h"
+#include "../src/divide_conquer/radix_sort.h"
+#include "../src/divide_conquer/parallel_closest_pair.h"
+#include "../src/spatial/radius_join.h"
+#include "../src/spatial/dynamic_closest_pair.h"
+#include "../src/spatial/knn_graph.h"
+#include "../src/spatial/morton_closest_pair.h"
+#include "../src/spatial/spatial_index.h"
+#include "../src/spatial/bichromatic_closest_pair.h"
+#include "../src/common/thread_pool.h"
 #include "../src/common/data_generator.h"
 #include "../src/common/timer.h"
+#include "../src/common/benchmark.h"
+#include "../src/common/perf_counters.h"
+#include "../src/common/alloc_tracker.h"
+#include "../src/common/task_scheduler.h"
+#include "../src/common/pipeline.h"
+#include "../src/common/trace.h"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <cstdlib>
+#include <cctype>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <stdexcept>
 
 /**
  * @brief Run experiments to validate greedy algorithm
@@ -26,6 +58,140 @@ void print_header() {
     std::cout << "========================================\n\n";
 }
 
+/**
+ * @brief Command-line options shared by all experiments
+ */
+struct ExperimentOptions {
+    BenchmarkConfig bench;                                  // Warmups / repetition policy
+    std::map<std::string, std::vector<double>> sweeps;      // --sweep key=v1,v2,...
+    std::string format = "csv";                             // csv or json
+    int pin_cpu = -1;                                       // -1 = no pinning
+    int jobs = 1;                                           // Task threads (0 = hardware threads)
+    bool isolate = true;                                    // Timed trials run exclusively
+    bool pipeline = false;                                  // Generate / solve / write concurrently
+    int generators = 1;                                     // Generator threads under --pipeline
+    bool counters = true;                                   // Record hardware counters (--no-counters)
+    std::string save_baseline;                              // --save-baseline NAME
+    std::string compare_baseline;                           // --compare NAME
+    double threshold = 0.05;                                // Relative change flagged by --compare
+};
+
+ExperimentOptions options;
+
+// Runs (parameter, trial) tasks; configured by --jobs / --no-isolate
+TaskScheduler scheduler;
+
+/**
+ * @brief Pipeline layout for --pipeline: --generators generator threads and
+ *        one solver per job (a single solver for isolated, timed trials)
+ */
+PipelineConfig pipeline_config(TaskMode mode) {
+    PipelineConfig config;
+    config.generators = options.generators;
+    config.solvers = mode == TaskMode::Isolated && scheduler.isolation() ? 1 : scheduler.jobs();
+    config.queue_capacity = 2 * config.solvers;
+    return config;
+}
+
+/**
+ * @brief True if the solve steps of a batch in this mode run concurrently
+ *
+ * Their runtime_ms then includes contention for cores and caches and is
+ * not a measurement of the algorithm: experiments write -1 instead.
+ */
+bool concurrent_trials(TaskMode mode) {
+    return mode == TaskMode::Parallel && scheduler.jobs() > 1;
+}
+
+/**
+ * @brief Note on stdout that a batch's timing columns are -1
+ */
+void note_untimed(TaskMode mode) {
+    if (concurrent_trials(mode)) {
+        std::cout << "  Note: trials run concurrently (--jobs " << scheduler.jobs()
+                  << "), timing columns are -1\n";
+    }
+}
+
+/**
+ * @brief Run (parameter, trial) tasks split into a generate and a solve step
+ *
+ * write(t, result) is called for t = 0, 1, ... in order, so rows come out
+ * the same in both modes. By default each task generates and solves inside
+ * scheduler.map and the results are written afterwards. With --pipeline,
+ * generator, solver and writer threads run concurrently (run_pipeline):
+ * instances are produced ahead of the solvers and rows are written as soon
+ * as their trials are done.
+ */
+template <typename Generate, typename Solve, typename Write>
+void run_trials(int count, TaskMode mode, Generate generate, Solve solve, Write write) {
+    if (options.pipeline) {
+        PipelineStats stats = run_pipeline(count, pipeline_config(mode), generate, solve, write);
+        std::cout << "  Pipeline: " << std::fixed << std::setprecision(1) << stats.wall_ms
+                  << " ms wall, busy generate " << stats.generate_busy_ms << " / solve "
+                  << stats.solve_busy_ms << " / write " << stats.write_busy_ms << " ms"
+                  << (stats.pinned ? "" : " (solvers not pinned)") << "\n" << std::defaultfloat;
+        return;
+    }
+
+    auto results = scheduler.map(count, mode, [&](int t) {
+        auto instance = generate(t);
+        return solve(t, instance);
+    });
+    for (int t = 0; t < count; ++t) write(t, results[t]);
+}
+
+/**
+ * @brief Values of a sweep parameter: the --sweep override if given, else defaults
+ */
+template <typename T>
+std::vector<T> sweep_values(const std::string& key, std::vector<T> defaults) {
+    auto it = options.sweeps.find(key);
+    if (it == options.sweeps.end()) return defaults;
+
+    std::vector<T> values;
+    for (double v : it->second) values.push_back(static_cast<T>(v));
+    return values;
+}
+
+/**
+ * @brief CSV header for the hardware counter columns, e.g. "dc_cycles,dc_instructions,..."
+ */
+std::string counter_columns(const std::string& prefix = "") {
+    std::string cols;
+    for (const char* name : {"cycles", "instructions", "ipc", "l1d_misses", "llc_misses", "branch_misses"}) {
+        cols += (cols.empty() ? "" : ",") + prefix + name;
+    }
+    return cols;
+}
+
+/**
+ * @brief Counter values in counter_columns order (-1 where unavailable)
+ */
+void write_counters(std::ostream& out, const PerfCounts& c) {
+    out << c.cycles << "," << c.instructions << "," << c.ipc() << ","
+        << c.l1d_misses << "," << c.llc_misses << "," << c.branch_misses;
+}
+
+/**
+ * @brief CSV header for the memory columns, e.g. "dc_allocations,dc_bytes_allocated,..."
+ */
+std::string memory_columns(const std::string& prefix = "") {
+    std::string cols;
+    for (const char* name : {"allocations", "bytes_allocated", "peak_live_bytes", "rss_kb", "peak_rss_kb"}) {
+        cols += (cols.empty() ? "" : ",") + prefix + name;
+    }
+    return cols;
+}
+
+/**
+ * @brief Memory values in memory_columns order (-1 unless built with TRACK_ALLOC)
+ */
+void write_memory(std::ostream& out, const AllocStats& m) {
+    out << m.allocations << "," << m.bytes_allocated << "," << m.peak_live_bytes << ","
+        << m.rss_kb << "," << m.peak_rss_kb;
+}
+
 /**
  * @brief Experiment 1: Runtime vs n (scalability test)
  */
@@ -33,46 +199,36 @@ void experiment_runtime_vs_n(const std::string& output_file) {
     std::cout << "Experiment 1: Runtime vs n...\n";
 
     std::ofstream out(output_file);
-    out << "n,k,avg_runtime_ms,std_runtime_ms,coverage\n";
+    out << "n,k,avg_runtime_ms,std_runtime_ms,coverage,median_ms,p90_ms,p99_ms,ci95_ms,reps,"
+        << counter_columns() << "," << memory_columns() << "\n";
 
-    std::vector<int> n_values = {100, 200, 500, 1000, 2000, 5000, 10000};
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{100, 200, 500, 1000, 2000, 5000, 10000});
     int k = 20;
     int total_locations = 5000;
     int avg_locations = 50;
-    int trials = 10;
 
     DataGenerator gen(42);
 
     for (int n : n_values) {
         std::cout << "  n = " << n << "..." << std::flush;
 
-        std::vector<double> runtimes;
-        int total_coverage = 0;
-
-        for (int trial = 0; trial < trials; ++trial) {
-            auto users = gen.generate_uniform(n, total_locations, avg_locations);
-            auto result = greedy_max_coverage(users, k);
-            runtimes.push_back(result.runtime_ms);
-            total_coverage += result.coverage;
-        }
-
-        // Compute statistics
-        double mean_runtime = 0.0;
-        for (double rt : runtimes) mean_runtime += rt;
-        mean_runtime /= trials;
-
-        double std_runtime = 0.0;
-        for (double rt : runtimes) {
-            std_runtime += (rt - mean_runtime) * (rt - mean_runtime);
-        }
-        std_runtime = std::sqrt(std_runtime / trials);
+        // One instance per n, generated outside the timed region
+        auto users = gen.generate_uniform(n, total_locations, avg_locations);
+        CoverageResult last;
 
-        double avg_coverage = total_coverage / (double)trials;
+        BenchmarkStats stats = run_benchmark(options.bench,
+            [&] { return &users; },
+            [&](const std::vector<User>* u) { last = greedy_max_coverage(*u, k); });
 
-        out << n << "," << k << "," << mean_runtime << ","
-            << std_runtime << "," << avg_coverage << "\n";
+        out << n << "," << k << "," << stats.mean_ms << "," << stats.stddev_ms << ","
+            << last.coverage << "," << stats.median_ms << "," << stats.p90_ms << ","
+            << stats.p99_ms << "," << stats.ci95_ms << "," << stats.reps << ",";
+        write_counters(out, last.counters);
+        out << ",";
+        write_memory(out, last.memory);
+        out << "\n";
 
-        std::cout << " done (avg: " << mean_runtime << " ms)\n";
+        std::cout << " done (median: " << stats.median_ms << " ms, " << stats.reps << " reps)\n";
     }
 
     out.close();
@@ -92,39 +248,48 @@ void experiment_coverage_vs_k(const std::string& output_file) {
     int total_locations = 5000;
     int avg_locations = 50;
     int trials = 10;
-    std::vector<int> k_values = {5, 10, 15, 20, 30, 50, 75, 100};
-
-    DataGenerator gen(42);
-
-    for (int k : k_values) {
-        std::cout << "  k = " << k << "..." << std::flush;
-
-        double greedy_cov = 0.0, random_cov = 0.0;
-        double greedy_time = 0.0, random_time = 0.0;
-
-        for (int trial = 0; trial < trials; ++trial) {
-            auto users = gen.generate_uniform(n, total_locations, avg_locations);
-
-            auto greedy_result = greedy_max_coverage(users, k);
-            auto random_result = random_max_coverage(users, k, trial);
+    std::vector<int> k_values = sweep_values("k", std::vector<int>{5, 10, 15, 20, 30, 50, 75, 100});
+
+    // One task per (k, trial), each with its own seed; one row per k
+    struct Trial { CoverageResult greedy, random; };
+    double greedy_cov = 0.0, random_cov = 0.0;
+    double greedy_time = 0.0, random_time = 0.0;
+    const bool timed = !concurrent_trials(TaskMode::Parallel);
+    note_untimed(TaskMode::Parallel);
+
+    run_trials(k_values.size() * trials, TaskMode::Parallel,
+        [&](int t) {
+            DataGenerator gen(task_seed("coverage_vs_k", k_values[t / trials], t % trials));
+            return gen.generate_uniform(n, total_locations, avg_locations);
+        },
+        [&](int t, const std::vector<User>& users) {
+            int k = k_values[t / trials];
+            return Trial{greedy_max_coverage(users, k), random_max_coverage(users, k, t % trials)};
+        },
+        [&](int t, const Trial& r) {
+            int k = k_values[t / trials], trial = t % trials;
+            if (trial == 0) {
+                std::cout << "  k = " << k << "..." << std::flush;
+                greedy_cov = random_cov = greedy_time = random_time = 0.0;
+            }
 
-            greedy_cov += greedy_result.coverage;
-            random_cov += random_result.coverage;
-            greedy_time += greedy_result.runtime_ms;
-            random_time += random_result.runtime_ms;
-        }
+            greedy_cov += r.greedy.coverage;
+            random_cov += r.random.coverage;
+            greedy_time += r.greedy.runtime_ms;
+            random_time += r.random.runtime_ms;
+            if (trial < trials - 1) return;
 
-        greedy_cov /= trials;
-        random_cov /= trials;
-        greedy_time /= trials;
-        random_time /= trials;
+            greedy_cov /= trials;
+            random_cov /= trials;
+            greedy_time = timed ? greedy_time / trials : -1;
+            random_time = timed ? random_time / trials : -1;
 
-        out << k << "," << greedy_cov << "," << random_cov << ","
-            << greedy_time << "," << random_time << "\n";
+            out << k << "," << greedy_cov << "," << random_cov << ","
+                << greedy_time << "," << random_time << "\n";
 
-        std::cout << " done (greedy: " << greedy_cov
-                  << ", random: " << random_cov << ")\n";
-    }
+            std::cout << " done (greedy: " << greedy_cov
+                      << ", random: " << random_cov << ")\n";
+        });
 
     out.close();
     std::cout << "  Results saved to " << output_file << "\n\n";
@@ -144,48 +309,59 @@ void experiment_approximation_ratio(const std::string& output_file) {
     int avg_locations = 20;
     int trials = 5;
 
-    DataGenerator gen(42);
-
     // Small instances only (brute force is exponential)
     std::vector<std::pair<int, int>> configs = {
         {10, 3}, {10, 5}, {12, 4}, {15, 5}, {15, 7}, {18, 5}, {20, 5}
     };
 
-    for (auto [n, k] : configs) {
-        std::cout << "  n = " << n << ", k = " << k << "..." << std::flush;
-
-        double greedy_cov = 0.0, optimal_cov = 0.0;
-        double greedy_time = 0.0, optimal_time = 0.0;
-        double ratio_sum = 0.0;
-
-        for (int trial = 0; trial < trials; ++trial) {
-            auto users = gen.generate_uniform(n, total_locations, avg_locations);
-
-            auto greedy_result = greedy_max_coverage(users, k);
-            auto optimal_result = brute_force_max_coverage(users, k);
+    // One task per (config, trial); the brute-force searches dominate
+    struct Trial { CoverageResult greedy, optimal; };
+    double greedy_cov = 0.0, optimal_cov = 0.0;
+    double greedy_time = 0.0, optimal_time = 0.0;
+    double ratio_sum = 0.0;
+    const bool timed = !concurrent_trials(TaskMode::Parallel);
+    note_untimed(TaskMode::Parallel);
+
+    run_trials(configs.size() * trials, TaskMode::Parallel,
+        [&](int t) {
+            auto [n, k] = configs[t / trials];
+            DataGenerator gen(task_seed("approximation_ratio", n * 1000LL + k, t % trials));
+            return gen.generate_uniform(n, total_locations, avg_locations);
+        },
+        [&](int t, const std::vector<User>& users) {
+            int k = configs[t / trials].second;
+            return Trial{greedy_max_coverage(users, k), brute_force_max_coverage(users, k)};
+        },
+        [&](int t, const Trial& r) {
+            auto [n, k] = configs[t / trials];
+            int trial = t % trials;
+            if (trial == 0) {
+                std::cout << "  n = " << n << ", k = " << k << "..." << std::flush;
+                greedy_cov = optimal_cov = greedy_time = optimal_time = ratio_sum = 0.0;
+            }
 
-            greedy_cov += greedy_result.coverage;
-            optimal_cov += optimal_result.coverage;
-            greedy_time += greedy_result.runtime_ms;
-            optimal_time += optimal_result.runtime_ms;
+            greedy_cov += r.greedy.coverage;
+            optimal_cov += r.optimal.coverage;
+            greedy_time += r.greedy.runtime_ms;
+            optimal_time += r.optimal.runtime_ms;
 
-            double ratio = optimal_result.coverage > 0 ?
-                (double)greedy_result.coverage / optimal_result.coverage : 1.0;
+            double ratio = r.optimal.coverage > 0 ?
+                (double)r.greedy.coverage / r.optimal.coverage : 1.0;
             ratio_sum += ratio;
-        }
+            if (trial < trials - 1) return;
 
-        greedy_cov /= trials;
-        optimal_cov /= trials;
-        greedy_time /= trials;
-        optimal_time /= trials;
-        double avg_ratio = ratio_sum / trials;
+            greedy_cov /= trials;
+            optimal_cov /= trials;
+            greedy_time = timed ? greedy_time / trials : -1;
+            optimal_time = timed ? optimal_time / trials : -1;
+            double avg_ratio = ratio_sum / trials;
 
-        out << n << "," << k << "," << greedy_cov << "," << optimal_cov << ","
-            << avg_ratio << "," << greedy_time << "," << optimal_time << "\n";
+            out << n << "," << k << "," << greedy_cov << "," << optimal_cov << ","
+                << avg_ratio << "," << greedy_time << "," << optimal_time << "\n";
 
-        std::cout << " ratio = " << std::fixed << std::setprecision(3)
-                  << avg_ratio << "\n";
-    }
+            std::cout << " ratio = " << std::fixed << std::setprecision(3)
+                      << avg_ratio << "\n";
+        });
 
     out.close();
     std::cout << "  Results saved to " << output_file << "\n\n";
@@ -210,33 +386,43 @@ void experiment_zipf_distribution(const std::string& output_file) {
         {1000, 20}, {1000, 50}
     };
 
-    DataGenerator gen(42);
-
-    for (auto [n, k] : configs) {
-        std::cout << "  n = " << n << ", k = " << k << "..." << std::flush;
-
-        double greedy_cov = 0.0, random_cov = 0.0, greedy_time = 0.0;
-
-        for (int trial = 0; trial < trials; ++trial) {
-            auto users = gen.generate_zipf(n, total_locations, avg_locations, alpha);
-
-            auto greedy_result = greedy_max_coverage(users, k);
-            auto random_result = random_max_coverage(users, k, trial);
+    struct Trial { CoverageResult greedy, random; };
+    double greedy_cov = 0.0, random_cov = 0.0, greedy_time = 0.0;
+    const bool timed = !concurrent_trials(TaskMode::Parallel);
+    note_untimed(TaskMode::Parallel);
+
+    run_trials(configs.size() * trials, TaskMode::Parallel,
+        [&](int t) {
+            auto [n, k] = configs[t / trials];
+            DataGenerator gen(task_seed("zipf_distribution", n * 1000LL + k, t % trials));
+            return gen.generate_zipf(n, total_locations, avg_locations, alpha);
+        },
+        [&](int t, const std::vector<User>& users) {
+            int k = configs[t / trials].second;
+            return Trial{greedy_max_coverage(users, k), random_max_coverage(users, k, t % trials)};
+        },
+        [&](int t, const Trial& r) {
+            auto [n, k] = configs[t / trials];
+            int trial = t % trials;
+            if (trial == 0) {
+                std::cout << "  n = " << n << ", k = " << k << "..." << std::flush;
+                greedy_cov = random_cov = greedy_time = 0.0;
+            }
 
-            greedy_cov += greedy_result.coverage;
-            random_cov += random_result.coverage;
-            greedy_time += greedy_result.runtime_ms;
-        }
+            greedy_cov += r.greedy.coverage;
+            random_cov += r.random.coverage;
+            greedy_time += r.greedy.runtime_ms;
+            if (trial < trials - 1) return;
 
-        greedy_cov /= trials;
-        random_cov /= trials;
-        greedy_time /= trials;
+            greedy_cov /= trials;
+            random_cov /= trials;
+            greedy_time = timed ? greedy_time / trials : -1;
 
-        out << n << "," << k << "," << greedy_cov << ","
-            << random_cov << "," << greedy_time << "\n";
+            out << n << "," << k << "," << greedy_cov << ","
+                << random_cov << "," << greedy_time << "\n";
 
-        std::cout << " done (greedy: " << greedy_cov << ")\n";
-    }
+            std::cout << " done (greedy: " << greedy_cov << ")\n";
+        });
 
     out.close();
     std::cout << "  Results saved to " << output_file << "\n\n";
@@ -298,94 +484,60 @@ void experiment_closest_pair_runtime(const std::string& output_file) {
     std::cout << "Experiment 5: Closest Pair - Runtime vs n (O(n log n) vs O(n^2))...\n";
 
     std::ofstream out(output_file);
-    out << "n,dc_runtime_ms,dc_std_ms,bf_runtime_ms,bf_std_ms,dc_comparisons,bf_comparisons,distance\n";
-
-    // Test different problem sizes
-    std::vector<int> n_values = {100, 200, 500, 1000, 2000, 5000};
-    std::vector<int> n_values_large = {10000, 20000, 50000};
+    out << "n,dc_runtime_ms,dc_std_ms,bf_runtime_ms,bf_std_ms,dc_comparisons,bf_comparisons,distance,"
+        << "dc_median_ms,dc_p99_ms,dc_reps,bf_median_ms,bf_p99_ms,bf_reps,"
+        << counter_columns("dc_") << "," << counter_columns("bf_") << ","
+        << memory_columns("dc_") << "," << memory_columns("bf_") << "\n";
 
-    int trials = 10;
+    // Brute force only runs up to bf_max_n
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{100, 200, 500, 1000, 2000, 5000,
+                                                                   10000, 20000, 50000});
+    const int bf_max_n = 5000;
 
-    // Small to medium sizes (both algorithms)
     for (int n : n_values) {
-        std::cout << "  n = " << n << "..." << std::flush;
-
-        std::vector<double> dc_runtimes, bf_runtimes;
-        int dc_comps = 0, bf_comps = 0;
-        double min_dist = 0.0;
-
-        for (int trial = 0; trial < trials; ++trial) {
-            auto points = generate_uniform_points(n, 0.0, 1000.0, 42 + trial);
-
-            // Divide and conquer
-            auto points_dc = points;
-            auto dc_result = divide_conquer_closest_pair(points_dc);
-            dc_runtimes.push_back(dc_result.runtime_ms);
-            dc_comps += dc_result.comparisons;
-
-            // Brute force
-            auto bf_result = brute_force_closest_pair(points);
-            bf_runtimes.push_back(bf_result.runtime_ms);
-            bf_comps += bf_result.comparisons;
-
-            min_dist += dc_result.distance;
-        }
-
-        // Compute statistics
-        double dc_mean = 0.0, bf_mean = 0.0;
-        for (int i = 0; i < trials; ++i) {
-            dc_mean += dc_runtimes[i];
-            bf_mean += bf_runtimes[i];
-        }
-        dc_mean /= trials;
-        bf_mean /= trials;
-
-        double dc_std = 0.0, bf_std = 0.0;
-        for (int i = 0; i < trials; ++i) {
-            dc_std += (dc_runtimes[i] - dc_mean) * (dc_runtimes[i] - dc_mean);
-            bf_std += (bf_runtimes[i] - bf_mean) * (bf_runtimes[i] - bf_mean);
+        bool run_bf = n <= bf_max_n;
+        std::cout << "  n = " << n << (run_bf ? "" : " (DC only)") << "..." << std::flush;
+
+        auto points = generate_uniform_points(n, 0.0, 1000.0, 42);
+        ClosestPairResult dc_result{}, bf_result{};
+
+        // divide_conquer_closest_pair sorts its input: each run gets a fresh copy
+        BenchmarkStats dc = run_benchmark(options.bench,
+            [&] { return points; },
+            [&](std::vector<Point>& p) { dc_result = divide_conquer_closest_pair(p); });
+
+        BenchmarkStats bf;
+        if (run_bf) {
+            bf = run_benchmark(options.bench,
+                [&] { return &points; },
+                [&](const std::vector<Point>* p) { bf_result = brute_force_closest_pair(*p); });
         }
-        dc_std = std::sqrt(dc_std / trials);
-        bf_std = std::sqrt(bf_std / trials);
-
-        out << n << "," << dc_mean << "," << dc_std << ","
-            << bf_mean << "," << bf_std << ","
-            << (dc_comps / trials) << "," << (bf_comps / trials) << ","
-            << (min_dist / trials) << "\n";
 
-        std::cout << " done (DC: " << dc_mean << " ms, BF: " << bf_mean << " ms)\n";
-    }
-
-    // Large sizes (only divide & conquer)
-    for (int n : n_values_large) {
-        std::cout << "  n = " << n << " (DC only)..." << std::flush;
-
-        std::vector<double> dc_runtimes;
-        int dc_comps = 0;
-        double min_dist = 0.0;
-
-        for (int trial = 0; trial < trials; ++trial) {
-            auto points = generate_uniform_points(n, 0.0, 1000.0, 42 + trial);
-            auto dc_result = divide_conquer_closest_pair(points);
-            dc_runtimes.push_back(dc_result.runtime_ms);
-            dc_comps += dc_result.comparisons;
-            min_dist += dc_result.distance;
+        out << n << "," << dc.mean_ms << "," << dc.stddev_ms << ",";
+        if (run_bf) {
+            out << bf.mean_ms << "," << bf.stddev_ms << ",";
+        } else {
+            out << "-1,-1,";
         }
-
-        double dc_mean = 0.0;
-        for (double rt : dc_runtimes) dc_mean += rt;
-        dc_mean /= trials;
-
-        double dc_std = 0.0;
-        for (double rt : dc_runtimes) {
-            dc_std += (rt - dc_mean) * (rt - dc_mean);
+        out << dc_result.comparisons << "," << (run_bf ? bf_result.comparisons : -1) << ","
+            << dc_result.distance << "," << dc.median_ms << "," << dc.p99_ms << "," << dc.reps << ",";
+        if (run_bf) {
+            out << bf.median_ms << "," << bf.p99_ms << "," << bf.reps << ",";
+        } else {
+            out << "-1,-1,0,";
         }
-        dc_std = std::sqrt(dc_std / trials);
-
-        out << n << "," << dc_mean << "," << dc_std << ",-1,-1,"
-            << (dc_comps / trials) << ",-1," << (min_dist / trials) << "\n";
-
-        std::cout << " done (DC: " << dc_mean << " ms)\n";
+        write_counters(out, dc_result.counters);
+        out << ",";
+        write_counters(out, bf_result.counters);    // All -1 when brute force was skipped
+        out << ",";
+        write_memory(out, dc_result.memory);
+        out << ",";
+        write_memory(out, bf_result.memory);
+        out << "\n";
+
+        std::cout << " done (DC: " << dc.median_ms << " ms";
+        if (run_bf) std::cout << ", BF: " << bf.median_ms << " ms";
+        std::cout << ")\n";
     }
 
     out.close();
@@ -401,7 +553,7 @@ void experiment_closest_pair_distributions(const std::string& output_file) {
     std::ofstream out(output_file);
     out << "n,distribution,runtime_ms,comparisons,min_distance\n";
 
-    std::vector<int> n_values = {1000, 5000, 10000};
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{1000, 5000, 10000});
     int trials = 10;
 
     for (int n : n_values) {
@@ -411,12 +563,15 @@ void experiment_closest_pair_distributions(const std::string& output_file) {
         {
             std::cout << "    Uniform..." << std::flush;
             double total_runtime = 0.0;
-            int total_comps = 0;
+            long long total_comps = 0;
             double total_dist = 0.0;
 
-            for (int trial = 0; trial < trials; ++trial) {
+            // Timed trials: exclusive under --jobs unless --no-isolate
+            auto results = scheduler.map(trials, TaskMode::Isolated, [&](int trial) {
                 auto points = generate_uniform_points(n, 0.0, 1000.0, 42 + trial);
-                auto result = divide_conquer_closest_pair(points);
+                return divide_conquer_closest_pair(points);
+            });
+            for (const auto& result : results) {
                 total_runtime += result.runtime_ms;
                 total_comps += result.comparisons;
                 total_dist += result.distance;
@@ -431,12 +586,15 @@ void experiment_closest_pair_distributions(const std::string& output_file) {
         {
             std::cout << "    Clustered..." << std::flush;
             double total_runtime = 0.0;
-            int total_comps = 0;
+            long long total_comps = 0;
             double total_dist = 0.0;
 
-            for (int trial = 0; trial < trials; ++trial) {
+            // Timed trials: exclusive under --jobs unless --no-isolate
+            auto results = scheduler.map(trials, TaskMode::Isolated, [&](int trial) {
                 auto points = generate_clustered_points(n, 10, 20.0, 42 + trial);
-                auto result = divide_conquer_closest_pair(points);
+                return divide_conquer_closest_pair(points);
+            });
+            for (const auto& result : results) {
                 total_runtime += result.runtime_ms;
                 total_comps += result.comparisons;
                 total_dist += result.distance;
@@ -459,67 +617,2111 @@ void experiment_closest_pair_complexity(const std::string& output_file) {
     std::cout << "Experiment 7: Closest Pair - Complexity Verification (O(n log n))...\n";
 
     std::ofstream out(output_file);
-    out << "n,runtime_ms,comparisons,n_log_n,n_squared\n";
+    out << "n,runtime_ms,comparisons,n_log_n,n_squared,median_ms,p90_ms,p99_ms,ci95_ms,std_ms,reps,"
+        << counter_columns() << "," << memory_columns() << "\n";
+
+    std::vector<int> n_values;
+    for (int n = 100; n <= 50000; n = (int)(n * 1.5)) {
+        n_values.push_back(n);
+    }
+    n_values = sweep_values("n", n_values);
+
+    for (int n : n_values) {
+        std::cout << "  n = " << n << "..." << std::flush;
+
+        auto points = generate_uniform_points(n, 0.0, 1000.0, 42);
+        ClosestPairResult last{};
+
+        BenchmarkStats stats = run_benchmark(options.bench,
+            [&] { return points; },
+            [&](std::vector<Point>& p) { last = divide_conquer_closest_pair(p); });
+
+        double n_log_n = n * std::log2(n);
+        double n_squared = (double)n * n;
+
+        out << n << "," << stats.mean_ms << "," << last.comparisons << ","
+            << n_log_n << "," << n_squared << "," << stats.median_ms << ","
+            << stats.p90_ms << "," << stats.p99_ms << "," << stats.ci95_ms << ","
+            << stats.stddev_ms << "," << stats.reps << ",";
+        write_counters(out, last.counters);
+        out << ",";
+        write_memory(out, last.memory);
+        out << "\n";
+
+        std::cout << " done (" << stats.median_ms << " ms)\n";
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 8: Fixed-radius join - all pairs within distance r
+ */
+void experiment_radius_join(const std::string& output_file) {
+    std::cout << "Experiment 8: Fixed-radius join (all pairs within r)...\n";
+
+    std::ofstream out(output_file);
+    out << "n,distribution,r,threads,pairs,candidates,runtime_ms,pairs_per_sec,bf_runtime_ms\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{10000, 50000, 100000});
+    std::vector<double> r_values = sweep_values("r", std::vector<double>{1.0, 5.0});
+    std::vector<int> thread_counts = sweep_values("threads", std::vector<int>{1, ThreadPool::hardware_threads()});
+    thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()),
+                        thread_counts.end());
+
+    for (int n : n_values) {
+        for (const std::string dist : {"uniform", "clustered"}) {
+            auto points = dist == "uniform"
+                ? generate_uniform_points(n, 0.0, 1000.0, 42)
+                : generate_clustered_points(n, 10, 20.0, 42);
+
+            for (double r : r_values) {
+                std::cout << "  n = " << n << ", " << dist << ", r = " << r
+                          << "..." << std::flush;
+
+                // Brute force reference only where it is affordable
+                double bf_runtime = -1;
+                long long bf_pairs = -1;
+                if (n <= 10000) {
+                    auto bf = brute_force_radius_join(points, r,
+                        [](int, const RadiusPair&) {});
+                    bf_runtime = bf.runtime_ms;
+                    bf_pairs = bf.pairs;
+                }
+
+                for (int threads : thread_counts) {
+                    auto result = radius_join(points, r,
+                        [](int, const RadiusPair&) {}, threads);
+
+                    if (bf_pairs >= 0 && bf_pairs != result.pairs) {
+                        std::cerr << " MISMATCH (grid " << result.pairs
+                                  << " vs brute force " << bf_pairs << ")";
+                    }
+
+                    out << n << "," << dist << "," << r << "," << threads << ","
+                        << result.pairs << "," << result.candidates << ","
+                        << result.runtime_ms << "," << result.pairs_per_second << ","
+                        << bf_runtime << "\n";
+                }
+                std::cout << " done\n";
+            }
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 9: Dynamic closest pair - update throughput vs recompute
+ *
+ * Users move by small random steps in batches. After every batch we compare
+ * the maintained answer with a full divide_conquer_closest_pair recompute.
+ */
+void experiment_dynamic_closest_pair(const std::string& output_file) {
+    std::cout << "Experiment 9: Dynamic closest pair - updates vs full recompute...\n";
+
+    std::ofstream out(output_file);
+    out << "n,batch_size,batches,dynamic_ms,updates_per_sec,recompute_ms,"
+           "recomputes_per_sec,speedup,rebuilds,mismatches\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{10000, 50000, 100000});
+    std::vector<int> batch_sizes = sweep_values("batch", std::vector<int>{10, 100, 1000});
+    int batches = 20;
+    double step = 2.0;
+
+    for (int n : n_values) {
+        for (int batch_size : batch_sizes) {
+            std::cout << "  n = " << n << ", batch = " << batch_size << "..." << std::flush;
+
+            auto points = generate_uniform_points(n, 0.0, 1000.0, 42);
+            DynamicClosestPair dynamic(points);
+            long long rebuilds_before = dynamic.stats().rebuilds;
+
+            std::mt19937 rng(7);
+            std::uniform_int_distribution<int> pick(0, n - 1);
+            std::uniform_real_distribution<double> delta(-step, step);
+
+            double dynamic_ms = 0.0, recompute_ms = 0.0;
+            int mismatches = 0;
+            Timer timer;
+
+            for (int b = 0; b < batches; ++b) {
+                // Precompute the batch so RNG cost is not timed
+                std::vector<Point> moves;
+                moves.reserve(batch_size);
+                for (int u = 0; u < batch_size; ++u) {
+                    int i = pick(rng);
+                    points[i].x += delta(rng);
+                    points[i].y += delta(rng);
+                    moves.push_back(points[i]);
+                }
+
+                timer.start();
+                for (const auto& p : moves) dynamic.move(p.id, p.x, p.y);
+                double maintained = dynamic.closest().distance;
+                timer.stop();
+                dynamic_ms += timer.elapsed_ms();
+
+                auto copy = points;
+                auto recomputed = divide_conquer_closest_pair(copy);
+                recompute_ms += recomputed.runtime_ms;
+
+                if (maintained != recomputed.distance) mismatches++;
+            }
+
+            double total_updates = (double)batch_size * batches;
+            double updates_per_sec = dynamic_ms > 0 ? total_updates / (dynamic_ms / 1000.0) : 0.0;
+            double recomputes_per_sec = recompute_ms > 0 ? batches / (recompute_ms / 1000.0) : 0.0;
+            double speedup = dynamic_ms > 0 ? recompute_ms / dynamic_ms : 0.0;
+
+            out << n << "," << batch_size << "," << batches << ","
+                << dynamic_ms << "," << updates_per_sec << ","
+                << recompute_ms << "," << recomputes_per_sec << ","
+                << speedup << "," << (dynamic.stats().rebuilds - rebuilds_before) << ","
+                << mismatches << "\n";
+
+            std::cout << " done (" << (long long)updates_per_sec << " updates/s, "
+                      << speedup << "x vs recompute)\n";
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 10: k-NN graph construction (all k nearest neighbors)
+ */
+void experiment_knn_graph(const std::string& output_file) {
+    std::cout << "Experiment 10: k-NN graph construction (static k-d tree)...\n";
+
+    std::ofstream out(output_file);
+    out << "n,k,threads,build_ms,query_ms,runtime_ms,queries_per_sec,bf_runtime_ms\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{10000, 100000, 1000000});
+    std::vector<int> k_values = sweep_values("k", std::vector<int>{5, 10});
+    std::vector<int> thread_counts = sweep_values("threads", std::vector<int>{1, ThreadPool::hardware_threads()});
+    thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()),
+                        thread_counts.end());
+
+    for (int n : n_values) {
+        auto points = generate_uniform_points(n, 0.0, 1000.0, 42);
+
+        for (int k : k_values) {
+            std::cout << "  n = " << n << ", k = " << k << "..." << std::flush;
+
+            // Brute force reference only where it is affordable
+            double bf_runtime = -1;
+            KnnGraph reference;
+            if (n <= 10000) {
+                reference = brute_force_knn_graph(points, k);
+                bf_runtime = reference.runtime_ms;
+            }
+
+            for (int threads : thread_counts) {
+                auto graph = build_knn_graph(points, k, threads);
+
+                if (bf_runtime >= 0 && graph.distances != reference.distances) {
+                    std::cerr << " MISMATCH against brute force";
+                }
+
+                double qps = graph.query_ms > 0 ? n / (graph.query_ms / 1000.0) : 0.0;
+                out << n << "," << k << "," << threads << ","
+                    << graph.build_ms << "," << graph.query_ms << ","
+                    << graph.runtime_ms << "," << qps << "," << bf_runtime << "\n";
+            }
+            std::cout << " done\n";
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 11: Compact point representations (bandwidth)
+ *
+ * Runs the same allocation-free engine on 24-byte Point, 12-byte PointF32
+ * and 12-byte PointFixed so the difference is the bytes moved per pass.
+ */
+void experiment_compact_points(const std::string& output_file) {
+    std::cout << "Experiment 11: Compact point representations (float64 vs float32 vs fixed32)...\n";
+
+    std::ofstream out(output_file);
+    out << "n,encoding,bytes_per_point,dataset_mb,encode_ms,solve_ms,"
+           "distance,abs_error,error_bound,dc_runtime_ms\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{1000000, 10000000});
+
+    for (int n : n_values) {
+        std::cout << "  n = " << n << "...\n";
+        auto points = generate_uniform_points(n, 0.0, 100000.0, 42);
+
+        // Original engine only where it finishes in reasonable time
+        double dc_runtime = -1;
+        if (n <= 1000000) {
+            auto copy = points;
+            dc_runtime = divide_conquer_closest_pair(copy).runtime_ms;
+        }
+
+        double exact = 0.0;
+        Timer timer;
+
+        // Float64 (lossless): defines the exact answer
+        {
+            timer.start();
+            std::vector<Point> encoded(points);
+            timer.stop();
+            double encode_ms = timer.elapsed_ms();
+
+            auto result = compact_closest_pair(encoded);
+            exact = result.distance;
+            out << n << ",float64," << sizeof(Point) << ","
+                << n * sizeof(Point) / 1e6 << "," << encode_ms << ","
+                << result.runtime_ms << "," << result.distance << ",0,0,"
+                << dc_runtime << "\n";
+            std::cout << "    float64: " << result.runtime_ms << " ms\n";
+        }
+
+        // Float32
+        {
+            QuantizationReport report;
+            timer.start();
+            auto encoded = encode_float32(points, &report);
+            timer.stop();
+            double encode_ms = timer.elapsed_ms();
+
+            auto result = compact_closest_pair(encoded);
+            double dist = distance(points[result.p1.id], points[result.p2.id]);
+            out << n << ",float32," << sizeof(PointF32) << ","
+                << n * sizeof(PointF32) / 1e6 << "," << encode_ms << ","
+                << result.runtime_ms << "," << dist << "," << std::abs(dist - exact) << ","
+                << 2 * report.max_distance_error << "," << dc_runtime << "\n";
+            std::cout << "    float32: " << result.runtime_ms << " ms\n";
+        }
+
+        // Fixed32
+        {
+            QuantizationReport report;
+            timer.start();
+            auto encoded = encode_fixed(points, 0.0, &report);
+            timer.stop();
+            double encode_ms = timer.elapsed_ms();
+
+            auto result = compact_closest_pair(encoded);
+            double dist = distance(points[result.p1.id], points[result.p2.id]);
+            out << n << ",fixed32," << sizeof(PointFixed) << ","
+                << n * sizeof(PointFixed) / 1e6 << "," << encode_ms << ","
+                << result.runtime_ms << "," << dist << "," << std::abs(dist - exact) << ","
+                << 2 * report.max_distance_error << "," << dc_runtime << "\n";
+            std::cout << "    fixed32: " << result.runtime_ms << " ms\n";
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 12: External-memory closest pair under a memory budget
+ */
+void experiment_external_closest_pair(const std::string& output_file) {
+    std::cout << "Experiment 12: External-memory closest pair (bounded memory)...\n";
+
+    std::ofstream out(output_file);
+    out << "n,budget_mb,dataset_mb,runs,merge_passes,slabs,runtime_ms,io_ms,"
+           "bytes_read,bytes_written,throughput_mb_s,peak_buffer_mb,distance,in_memory_distance\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{1000000, 5000000});
+    std::vector<int> budgets_mb = sweep_values("budget_mb", std::vector<int>{8, 32, 128});
+    const std::string path = "/tmp/lbsn_points.bin";
+
+    for (int n : n_values) {
+        auto points = generate_uniform_points(n, 0.0, 100000.0, 42);
+        if (!write_points_file(path, points)) {
+            std::cerr << "  Cannot write " << path << ", skipping\n";
+            return;
+        }
+
+        auto copy = points;
+        double in_memory = compact_closest_pair(copy).distance;
+        std::vector<Point>().swap(copy);
+        std::vector<Point>().swap(points);
+
+        for (int budget_mb : budgets_mb) {
+            std::cout << "  n = " << n << ", budget = " << budget_mb << " MB..." << std::flush;
+
+            ExternalConfig config;
+            config.memory_budget_bytes = (std::size_t)budget_mb << 20;
+            auto result = external_closest_pair(path, config);
+
+            out << n << "," << budget_mb << "," << n * 20.0 / 1e6 << ","
+                << result.runs << "," << result.merge_passes << "," << result.slabs << ","
+                << result.pair.runtime_ms << "," << result.io_ms << ","
+                << result.bytes_read << "," << result.bytes_written << ","
+                << result.throughput_mb_s << "," << result.peak_buffer_bytes / 1e6 << ","
+                << result.pair.distance << "," << in_memory << "\n";
+
+            std::cout << " done (" << result.pair.runtime_ms << " ms, "
+                      << result.throughput_mb_s << " MB/s)\n";
+        }
+    }
+    std::remove(path.c_str());
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 13: Share of closest pair runtime spent in the initial sorts
+ *
+ * "before" = the two comparison sorts (std::sort with (x, y) / (y, x)
+ * comparators) the engine used to run; "after" = the radix sorts it runs
+ * now. The share is relative to the total divide_conquer_closest_pair time
+ * with the respective sort.
+ */
+void experiment_sort_share(const std::string& output_file) {
+    std::cout << "Experiment 13: Closest Pair - sort share of runtime (std::sort vs radix)...\n";
+
+    std::ofstream out(output_file);
+    out << "n,comparison_sort_ms,radix_sort_ms,dc_runtime_ms,share_before,share_after\n";
 
     std::vector<int> n_values;
     for (int n = 100; n <= 50000; n = (int)(n * 1.5)) {
         n_values.push_back(n);
     }
+    n_values.push_back(1000000);
+    n_values = sweep_values("n", n_values);
+
+    auto by_x = [](const Point& a, const Point& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    };
+    auto by_y = [](const Point& a, const Point& b) {
+        return a.y < b.y || (a.y == b.y && a.x < b.x);
+    };
 
     int trials = 5;
+    Timer timer;
 
     for (int n : n_values) {
         std::cout << "  n = " << n << "..." << std::flush;
 
-        double total_runtime = 0.0;
-        int total_comps = 0;
+        double comparison_ms = 0.0, radix_ms = 0.0, dc_ms = 0.0;
 
         for (int trial = 0; trial < trials; ++trial) {
             auto points = generate_uniform_points(n, 0.0, 1000.0, 42 + trial);
-            auto result = divide_conquer_closest_pair(points);
-            total_runtime += result.runtime_ms;
-            total_comps += result.comparisons;
+
+            auto px = points, py = points;
+            timer.start();
+            std::sort(px.begin(), px.end(), by_x);
+            std::sort(py.begin(), py.end(), by_y);
+            timer.stop();
+            comparison_ms += timer.elapsed_ms();
+
+            px = points;
+            py = points;
+            timer.start();
+            radix_sort_points(px, SortAxis::X);
+            radix_sort_points(py, SortAxis::Y);
+            timer.stop();
+            radix_ms += timer.elapsed_ms();
+
+            dc_ms += divide_conquer_closest_pair(points).runtime_ms;
         }
 
-        double avg_runtime = total_runtime / trials;
-        int avg_comps = total_comps / trials;
-        double n_log_n = n * std::log2(n);
-        double n_squared = n * n;
+        comparison_ms /= trials;
+        radix_ms /= trials;
+        dc_ms /= trials;
+
+        double rest_ms = std::max(0.0, dc_ms - radix_ms);
+        double share_before = comparison_ms / (rest_ms + comparison_ms);
+        double share_after = dc_ms > 0 ? radix_ms / dc_ms : 0.0;
 
-        out << n << "," << avg_runtime << "," << avg_comps << ","
-            << n_log_n << "," << n_squared << "\n";
+        out << n << "," << comparison_ms << "," << radix_ms << "," << dc_ms << ","
+            << share_before << "," << share_after << "\n";
 
-        std::cout << " done (" << avg_runtime << " ms)\n";
+        std::cout << " done (sort share " << std::fixed << std::setprecision(2)
+                  << 100 * share_before << "% -> " << 100 * share_after << "%)\n"
+                  << std::defaultfloat;
     }
 
     out.close();
     std::cout << "  Results saved to " << output_file << "\n\n";
 }
 
-int main() {
-    print_header();
+/**
+ * @brief Experiment 14: Closest pair specialized per dimension
+ *
+ * 2D: closest_pair_nd<2, double> vs divide_conquer_closest_pair on the same
+ * points. 3D and 4D: the runtime-dispatched kernel (double and float32) vs
+ * brute force on small n, checking the distances agree.
+ */
+void experiment_closest_pair_dimensions(const std::string& output_file) {
+    std::cout << "Experiment 14: Closest Pair - compile-time dimension specialization...\n";
 
-    // Create output directory if it doesn't exist
-    system("mkdir -p experiments/data");
+    std::ofstream out(output_file);
+    out << "dims,n,nd_double_ms,nd_float_ms,baseline_ms,baseline,nd_distance,baseline_distance,comparisons\n";
 
-    // Run greedy algorithm experiments
-    std::cout << "\n===== GREEDY ALGORITHM EXPERIMENTS =====\n\n";
-    experiment_runtime_vs_n("experiments/data/runtime_vs_n.csv");
-    experiment_coverage_vs_k("experiments/data/coverage_vs_k.csv");
-    experiment_approximation_ratio("experiments/data/approximation_ratio.csv");
-    experiment_zipf_distribution("experiments/data/zipf_distribution.csv");
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{1000, 10000, 100000, 1000000});
+    int trials = 3;
 
-    // Run closest pair experiments
-    std::cout << "\n===== DIVIDE & CONQUER EXPERIMENTS =====\n\n";
-    experiment_closest_pair_runtime("experiments/data/closest_pair_runtime.csv");
-    experiment_closest_pair_distributions("experiments/data/closest_pair_distributions.csv");
-    experiment_closest_pair_complexity("experiments/data/closest_pair_complexity.csv");
+    for (int n : n_values) {
+        std::cout << "  2D n = " << n << "..." << std::flush;
+        double nd_ms = 0.0, f32_ms = 0.0, dc_ms = 0.0;
+        double nd_dist = 0.0, dc_dist = 0.0;
+        long long comparisons = 0;
 
-    std::cout << "========================================\n";
-    std::cout << "All experiments completed!\n";
-    std::cout << "Results saved in experiments/data/\n";
-    std::cout << "Run Python scripts to generate plots.\n";
-    std::cout << "========================================\n";
+        for (int trial = 0; trial < trials; ++trial) {
+            auto points = generate_uniform_points(n, 0.0, 1000.0, 42 + trial);
 
+            std::vector<double> coords(2 * n);
+            std::vector<int> ids(n);
+            for (int i = 0; i < n; ++i) {
+                coords[2 * i] = points[i].x;
+                coords[2 * i + 1] = points[i].y;
+                ids[i] = points[i].id;
+            }
+
+            std::vector<PointND<2, double>> nd_points(n);
+            for (int i = 0; i < n; ++i) nd_points[i] = {{points[i].x, points[i].y}, points[i].id};
+
+            auto nd = closest_pair_nd(nd_points);
+            auto f32 = closest_pair_any_dim(2, coords, ids, PointEncoding::Float32);
+            auto dc = divide_conquer_closest_pair(points);
+
+            nd_ms += nd.runtime_ms;
+            f32_ms += f32.runtime_ms;
+            dc_ms += dc.runtime_ms;
+            nd_dist = nd.distance;
+            dc_dist = dc.distance;
+            comparisons = nd.comparisons;
+        }
+
+        out << 2 << "," << n << "," << nd_ms / trials << "," << f32_ms / trials << ","
+            << dc_ms / trials << ",divide_conquer," << nd_dist << "," << dc_dist << ","
+            << comparisons << "\n";
+        std::cout << " done\n";
+    }
+
+    for (int dims = 3; dims <= 4; ++dims) {
+        for (int n : sweep_values("n", std::vector<int>{1000, 5000, 20000, 100000, 1000000})) {
+            std::cout << "  " << dims << "D n = " << n << "..." << std::flush;
+
+            std::mt19937 gen(42 + n);
+            std::uniform_real_distribution<double> coord(0.0, 1000.0);
+            std::vector<double> coords(static_cast<size_t>(dims) * n);
+            std::vector<int> ids(n);
+            for (auto& c : coords) c = coord(gen);
+            for (int i = 0; i < n; ++i) ids[i] = i;
+
+            auto nd = closest_pair_any_dim(dims, coords, ids);
+            auto f32 = closest_pair_any_dim(dims, coords, ids, PointEncoding::Float32);
+
+            // Brute force only where it finishes in reasonable time
+            double bf_ms = -1.0, bf_dist = -1.0;
+            if (n <= 20000) {
+                Timer timer;
+                timer.start();
+                double best = std::numeric_limits<double>::infinity();
+                for (int i = 0; i < n; ++i) {
+                    for (int j = i + 1; j < n; ++j) {
+                        double d2 = 0.0;
+                        for (int k = 0; k < dims; ++k) {
+                            double d = coords[i * dims + k] - coords[j * dims + k];
+                            d2 += d * d;
+                        }
+                        best = std::min(best, d2);
+                    }
+                }
+                timer.stop();
+                bf_ms = timer.elapsed_ms();
+                bf_dist = std::sqrt(best);
+            }
+
+            out << dims << "," << n << "," << nd.runtime_ms << "," << f32.runtime_ms << ","
+                << bf_ms << ",brute_force," << nd.distance << "," << bf_dist << ","
+                << nd.comparisons << "\n";
+            std::cout << " done\n";
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 15: Morton-order approximate closest pair vs exact
+ *
+ * Approximate mode (no refinement) with window 1 and 2, and the refined
+ * exact mode, against divide_conquer_closest_pair: speedup and the
+ * observed distance ratio next to the worst-case bound.
+ */
+void experiment_morton_closest_pair(const std::string& output_file) {
+    std::cout << "Experiment 15: Closest Pair - Morton-order approximation...\n";
+
+    std::ofstream out(output_file);
+    out << "distribution,n,mode,window,runtime_ms,dc_runtime_ms,speedup,distance_ratio,bound,comparisons\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{10000, 100000, 1000000, 4000000});
+    int trials = 3;
+
+    for (const std::string dist : {"uniform", "clustered"}) {
+        for (int n : n_values) {
+            std::cout << "  " << dist << " n = " << n << "..." << std::flush;
+
+            struct Mode { const char* name; double epsilon; int window; };
+            const Mode modes[] = {
+                {"approximate", 10.0, 1},
+                {"approximate", 10.0, 2},
+                {"exact", 0.0, 2},
+            };
+
+            double dc_ms = 0.0;
+            double ms[3] = {0, 0, 0}, worst_ratio[3] = {1, 1, 1}, bound[3] = {0, 0, 0};
+            long long comparisons[3] = {0, 0, 0};
+
+            for (int trial = 0; trial < trials; ++trial) {
+                auto points = dist == "uniform"
+                    ? generate_uniform_points(n, 0.0, 1000.0, 42 + trial)
+                    : generate_clustered_points(n, 20, 50.0, 42 + trial);
+
+                auto dc = divide_conquer_closest_pair(points);
+                dc_ms += dc.runtime_ms;
+
+                for (int m = 0; m < 3; ++m) {
+                    auto r = morton_closest_pair(points, modes[m].epsilon, modes[m].window);
+                    ms[m] += r.runtime_ms;
+                    bound[m] = r.approximation_bound;
+                    comparisons[m] = r.comparisons;
+                    if (dc.distance > 0) {
+                        worst_ratio[m] = std::max(worst_ratio[m], r.distance / dc.distance);
+                    }
+                }
+            }
+
+            dc_ms /= trials;
+            for (int m = 0; m < 3; ++m) {
+                ms[m] /= trials;
+                out << dist << "," << n << "," << modes[m].name << "," << modes[m].window << ","
+                    << ms[m] << "," << dc_ms << "," << (ms[m] > 0 ? dc_ms / ms[m] : 0.0) << ","
+                    << worst_ratio[m] << "," << bound[m] << "," << comparisons[m] << "\n";
+            }
+
+            std::cout << " done (approx " << std::fixed << std::setprecision(1)
+                      << (ms[1] > 0 ? dc_ms / ms[1] : 0.0) << "x, exact "
+                      << (ms[2] > 0 ? dc_ms / ms[2] : 0.0) << "x)\n" << std::defaultfloat;
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 16: Subset closest-pair queries on a prebuilt index
+ *
+ * One SpatialIndex over 1M points answers thousands of random bounding-box
+ * and id-filter queries of a given expected subset size. The baseline
+ * copies each subset and runs divide_conquer_closest_pair on it (which
+ * re-sorts). Latency is reported as mean / median / p99 per query.
+ */
+void experiment_spatial_index(const std::string& output_file) {
+    std::cout << "Experiment 16: Closest Pair - prebuilt index for subset queries...\n";
+
+    std::ofstream out(output_file);
+    out << "query,target_size,queries,mean_subset,index_mean_ms,index_p50_ms,index_p99_ms,"
+        << "recompute_mean_ms,speedup,build_ms\n";
+
+    const int n = 1000000;
+    const double world = 1000.0;
+    auto points = generate_uniform_points(n, 0.0, world, 42);
+
+    Timer timer;
+    timer.start();
+    SpatialIndex index(points);
+    timer.stop();
+    double build_ms = timer.elapsed_ms();
+    std::cout << "  index build: " << build_ms << " ms (" << index.levels() << " grid levels)\n";
+
+    auto percentile = [](std::vector<double> v, double q) {
+        std::sort(v.begin(), v.end());
+        return v[std::min(v.size() - 1, static_cast<size_t>(q * v.size()))];
+    };
+
+    std::mt19937 gen(7);
+    for (const std::string query : {"bbox", "ids"}) {
+        for (int target : sweep_values("size", std::vector<int>{100, 1000, 10000, 100000})) {
+            int queries = target >= 100000 ? 100 : 2000;
+            std::cout << "  " << query << " subset ~" << target << " (" << queries
+                      << " queries)..." << std::flush;
+
+            std::vector<double> index_ms, recompute_ms;
+            long long subset_total = 0;
+
+            for (int q = 0; q < queries; ++q) {
+                std::vector<Point> subset;
+                ClosestPairResult indexed;
+
+                if (query == "bbox") {
+                    // Square box covering target/n of the area
+                    double w = world * std::sqrt(static_cast<double>(target) / n);
+                    std::uniform_real_distribution<double> corner(0.0, world - w);
+                    BoundingBox box{corner(gen), corner(gen), 0, 0};
+                    box.max_x = box.min_x + w;
+                    box.max_y = box.min_y + w;
+
+                    indexed = index.closest_pair_in_box(box);
+                    timer.start();
+                    for (const auto& p : points) {
+                        if (box.contains(p.x, p.y)) subset.push_back(p);
+                    }
+                } else {
+                    std::uniform_int_distribution<int> pick(0, n - 1);
+                    std::vector<int> ids(target);
+                    for (auto& id : ids) id = pick(gen);
+
+                    indexed = index.closest_pair_of_ids(ids);
+                    timer.start();
+                    std::sort(ids.begin(), ids.end());
+                    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+                    for (int id : ids) subset.push_back(points[id]);
+                }
+
+                auto recomputed = divide_conquer_closest_pair(subset);
+                timer.stop();
+
+                if (recomputed.distance != indexed.distance) {
+                    std::cerr << "Warning: index and recompute disagree\n";
+                }
+                index_ms.push_back(indexed.runtime_ms);
+                recompute_ms.push_back(timer.elapsed_ms());
+                subset_total += subset.size();
+            }
+
+            double index_mean = 0, recompute_mean = 0;
+            for (double t : index_ms) index_mean += t;
+            for (double t : recompute_ms) recompute_mean += t;
+            index_mean /= queries;
+            recompute_mean /= queries;
+
+            out << query << "," << target << "," << queries << ","
+                << static_cast<double>(subset_total) / queries << ","
+                << index_mean << "," << percentile(index_ms, 0.5) << ","
+                << percentile(index_ms, 0.99) << "," << recompute_mean << ","
+                << (index_mean > 0 ? recompute_mean / index_mean : 0.0) << ","
+                << build_ms << "\n";
+
+            std::cout << " done (" << std::fixed << std::setprecision(3) << index_mean
+                      << " ms vs " << recompute_mean << " ms)\n" << std::defaultfloat;
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 17: Phase breakdown of the greedy and closest pair engines
+ *
+ * Needs a tracing build (make TRACE=1); otherwise only the headers are
+ * written. Besides the phase table, writes per-iteration greedy records,
+ * strip sizes per recursion depth, and a folded-stack file for flame graphs
+ * (flamegraph.pl phase_profile.folded > phase_profile.svg).
+ */
+void experiment_phase_profile(const std::string& output_file) {
+    std::cout << "Experiment 17: Phase profile (greedy and closest pair)...\n";
+
+    std::string stem = output_file.substr(0, output_file.size() - 4);
+    std::ofstream out(output_file);
+    std::ofstream iterations(stem + "_greedy_iterations.csv");
+    std::ofstream strips(stem + "_strips.csv");
+    std::ofstream folded(stem + ".folded");
+    out << "algorithm,n,phase,calls,inclusive_ms,self_ms,share\n";
+    iterations << "n,iteration,candidates_scanned,gain_evaluations,best_gain,best_user,elapsed_ms\n";
+    strips << "n,depth,strips,strip_points,avg_strip_size\n";
+
+    if (!TraceScope::compiled_in()) {
+        std::cout << "  Tracing not compiled in (build with make TRACE=1), nothing recorded\n\n";
+        return;
+    }
+
+    // Phases [first, last] of one engine, shares relative to the root phase
+    auto write_phases = [&](const char* algorithm, int n, const TraceLog& log,
+                            TracePhase first, TracePhase last) {
+        double total_ns = log.phase_ns[static_cast<int>(first)];
+        for (int p = static_cast<int>(first); p <= static_cast<int>(last); ++p) {
+            TracePhase phase = static_cast<TracePhase>(p);
+            out << algorithm << "," << n << "," << trace_phase_info(phase).name << ","
+                << log.phase_calls[p] << "," << log.phase_ns[p] / 1e6 << ","
+                << log.self_ns(phase) / 1e6 << ","
+                << (total_ns > 0 ? log.self_ns(phase) / total_ns : 0) << "\n";
+        }
+        std::stringstream stacks;
+        log.write_folded(stacks);
+        std::string line;
+        while (std::getline(stacks, line)) folded << "n=" << n << ";" << line << "\n";
+    };
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{10000, 100000, 1000000});
+    for (int n : n_values) {
+        std::cout << "  closest pair, n = " << n << "..." << std::flush;
+        auto points = generate_uniform_points(n, 0.0, 1000.0, 42);
+
+        TraceLog log;
+        {
+            TraceScope scope(log);
+            divide_conquer_closest_pair(points);
+        }
+        write_phases("closest_pair", n, log, TracePhase::ClosestPair, TracePhase::CpStripScan);
+        for (size_t d = 0; d < log.strips_by_depth.size(); ++d) {
+            long long count = log.strips_by_depth[d];
+            strips << n << "," << d << "," << count << "," << log.strip_points_by_depth[d] << ","
+                   << (count > 0 ? (double)log.strip_points_by_depth[d] / count : 0) << "\n";
+        }
+        std::cout << " done (strip scan "
+                  << log.self_ns(TracePhase::CpStripScan) * 100.0 /
+                     std::max(1LL, log.phase_ns[static_cast<int>(TracePhase::ClosestPair)])
+                  << "% of the call)\n";
+    }
+
+    DataGenerator gen(42);
+    const int k = 20;
+    for (int n : {1000, 5000}) {
+        std::cout << "  greedy, n = " << n << ", k = " << k << "..." << std::flush;
+        auto users = gen.generate_uniform(n, 5000, 50);
+
+        TraceLog log;
+        {
+            TraceScope scope(log);
+            greedy_max_coverage(users, k);
+        }
+        write_phases("greedy", n, log, TracePhase::Greedy, TracePhase::GreedyUpdate);
+        for (const auto& it : log.greedy_iterations) {
+            iterations << n << "," << it.iteration << "," << it.candidates_scanned << ","
+                       << it.gain_evaluations << "," << it.best_gain << "," << it.best_user << ","
+                       << it.elapsed_ms << "\n";
+        }
+        std::cout << " done\n";
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << " (+ _greedy_iterations.csv, _strips.csv, .folded)\n\n";
+}
+
+/**
+ * @brief Experiment 18: Many small instances, batch API vs one call per instance
+ *
+ * One instance per city: 20-200 users with about 10 check-ins each from a
+ * pool of 400 locations, k = 5, plus the users' coordinates for the
+ * closest pair. Compares a loop of greedy_max_coverage +
+ * divide_conquer_closest_pair calls with the packed batch entry points on
+ * a pool of one thread and of all threads.
+ */
+void experiment_batch_instances(const std::string& output_file) {
+    std::cout << "Experiment 18: Batch API for many small instances...\n";
+
+    std::ofstream out(output_file);
+    out << "instances,mode,threads,greedy_ms,closest_pair_ms,total_ms,instances_per_sec,"
+        << "speedup,pack_ms,mismatches\n";
+
+    std::vector<int> instance_counts = sweep_values("instances", std::vector<int>{1000, 5000, 20000});
+    const int k = 5;
+    const int hw_threads = ThreadPool::hardware_threads();
+
+    for (int count : instance_counts) {
+        std::cout << "  instances = " << count << "..." << std::flush;
+
+        std::vector<std::vector<User>> cities(count);
+        std::vector<std::vector<Point>> city_points(count);
+        for (int c = 0; c < count; ++c) {
+            unsigned seed = task_seed("batch_instances", count, c);
+            int n = 20 + (int)(seed % 181);
+            DataGenerator gen(seed);
+            cities[c] = gen.generate_uniform(n, 400, 10);
+            city_points[c] = generate_uniform_points(n, 0.0, 10.0, seed);
+        }
+
+        // Per-call baseline
+        std::vector<int> loop_coverage(count);
+        std::vector<double> loop_distance(count);
+        BenchmarkStats loop_greedy = run_benchmark(options.bench, [] { return 0; }, [&](int) {
+            for (int c = 0; c < count; ++c) loop_coverage[c] = greedy_max_coverage(cities[c], k).coverage;
+        });
+        BenchmarkStats loop_cp = run_benchmark(options.bench, [] { return 0; }, [&](int) {
+            for (int c = 0; c < count; ++c) loop_distance[c] = divide_conquer_closest_pair(city_points[c]).distance;
+        });
+        double loop_ms = loop_greedy.median_ms + loop_cp.median_ms;
+        out << count << ",per_call,1," << loop_greedy.median_ms << "," << loop_cp.median_ms << ","
+            << loop_ms << "," << count * 1000.0 / loop_ms << ",1,0,0\n";
+
+        // Pack once
+        Timer pack;
+        pack.start();
+        CoverageBatch coverage_batch;
+        PointBatch point_batch;
+        for (int c = 0; c < count; ++c) {
+            coverage_batch.add(cities[c], k);
+            point_batch.add(city_points[c]);
+        }
+        pack.stop();
+
+        std::vector<int> thread_counts = {1};
+        if (hw_threads > 1) thread_counts.push_back(hw_threads);
+        double best_rate = 0;
+        for (int threads : thread_counts) {
+            ThreadPool pool(threads);       // Started once, outside the timed calls
+            BatchCoverageResult greedy_result;
+            BatchClosestPairResult cp_result;
+            BenchmarkStats batch_greedy = run_benchmark(options.bench, [] { return 0; }, [&](int) {
+                greedy_result = greedy_max_coverage_batch(coverage_batch, pool);
+            });
+            BenchmarkStats batch_cp = run_benchmark(options.bench, [] { return 0; }, [&](int) {
+                cp_result = closest_pair_batch(point_batch, pool);
+            });
+
+            int mismatches = 0;
+            for (int c = 0; c < count; ++c) {
+                if (greedy_result.coverage[c] != loop_coverage[c]) mismatches++;
+                if (cp_result.distance[c] != loop_distance[c]) mismatches++;
+            }
+
+            double batch_ms = batch_greedy.median_ms + batch_cp.median_ms;
+            best_rate = std::max(best_rate, count * 1000.0 / batch_ms);
+            out << count << ",batch," << threads << "," << batch_greedy.median_ms << ","
+                << batch_cp.median_ms << "," << batch_ms << "," << count * 1000.0 / batch_ms << ","
+                << loop_ms / batch_ms << "," << pack.elapsed_ms() << "," << mismatches << "\n";
+            if (mismatches > 0) std::cerr << "  Warning: " << mismatches << " batch results differ\n";
+        }
+
+        std::cout << " done (" << std::fixed << std::setprecision(0) << count * 1000.0 / loop_ms
+                  << " -> " << best_rate << " instances/s)\n" << std::defaultfloat;
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Greedy input for the scaling suite: n users, about 10 locations each
+ *        from a pool of n / 10 (at least 1000) locations, k = 10
+ */
+struct GreedyScalingWorkload {
+    static constexpr const char* name = "greedy";
+    static constexpr int k = 10;
+    static constexpr int avg_locations = 10;
+    std::vector<User> users;
+
+    // User object (id + unordered_set), a 16-byte node per location (32 with
+    // malloc overhead) and a bucket pointer per location
+    static long long input_bytes(long long n) { return n * (64 + 40LL * avg_locations); }
+    static long long work_bytes(long long n) { return n; }          // selected flags
+
+    void generate(long long n, unsigned seed) {
+        users = DataGenerator(seed).generate_uniform((int)n, (int)std::max(1000LL, n / 10), avg_locations);
+    }
+    void release() { std::vector<User>().swap(users); }
+
+    double measure(int threads, BenchmarkStats& stats) {
+        CoverageResult last;
+        stats = run_benchmark(options.bench, [&] { return &users; },
+            [&](const std::vector<User>* u) { last = greedy_max_coverage_parallel(*u, k, threads); });
+        return last.coverage;
+    }
+};
+
+/**
+ * @brief Closest pair input for the scaling suite: n uniform points
+ */
+struct ClosestPairScalingWorkload {
+    static constexpr const char* name = "closest_pair";
+    std::vector<Point> points, work;
+
+    static long long input_bytes(long long n) { return n * (long long)sizeof(Point); }
+    // Working copy, then the radix sort peak: 16-byte keys and scratch plus
+    // the gather target (the slab engines' buffers come after and are smaller)
+    static long long work_bytes(long long n) { return n * (2 * (long long)sizeof(Point) + 32); }
+
+    void generate(long long n, unsigned seed) { points = generate_uniform_points((int)n, 0.0, 1000.0, seed); }
+    void release() {
+        std::vector<Point>().swap(points);
+        std::vector<Point>().swap(work);
+    }
+
+    double measure(int threads, BenchmarkStats& stats) {
+        ClosestPairResult last;
+        stats = run_benchmark(options.bench,
+            [&] { work.assign(points.begin(), points.end()); return &work; },     // Untimed
+            [&](std::vector<Point>* p) { last = parallel_closest_pair(*p, threads); });
+        return last.distance;
+    }
+};
+
+/**
+ * @brief Measure one series of (n, threads) configurations of a workload
+ *
+ * The first configuration that fits in memory is the reference: speedup is
+ * its time over each time, efficiency is speedup * reference threads /
+ * threads for strong scaling (same n) and reference time / time for weak
+ * scaling (n grows with threads). A configuration is skipped when its
+ * estimated input plus working set exceeds 90% of MemAvailable.
+ */
+template <typename Workload>
+void run_scaling_series(std::ofstream& out, Workload& workload, const std::string& scaling,
+                        const std::vector<std::pair<long long, int>>& configs) {
+    long long resident_n = -1;
+    double reference_ms = -1;
+    int reference_threads = 0;
+
+    for (auto [n, threads] : configs) {
+        std::cout << "  " << workload.name << " " << scaling << " n = " << n << ", threads = " << threads
+                  << "..." << std::flush;
+
+        // Only the working set is new while the input stays resident
+        long long estimated = Workload::input_bytes(n) + Workload::work_bytes(n);
+        long long needed = n == resident_n ? Workload::work_bytes(n) : estimated;
+        if (n != resident_n) {
+            workload.release();
+            resident_n = -1;
+        }
+        long long available_kb = process_memory::available_kb();
+        double estimated_mb = estimated / 1048576.0;
+        double available_mb = available_kb >= 0 ? available_kb / 1024.0 : -1;
+
+        if (available_kb >= 0 && needed > 0.9 * available_kb * 1024) {
+            out << workload.name << "," << scaling << "," << n << "," << threads << ",skipped_memory,"
+                << "-1,-1,0,-1,-1,-1,-1," << estimated_mb << "," << available_mb << ",-1\n";
+            std::cout << " skipped (needs ~" << std::fixed << std::setprecision(0) << estimated_mb
+                      << " MB, " << available_mb << " MB available)\n" << std::defaultfloat;
+            continue;
+        }
+
+        if (n != resident_n) {
+            workload.generate(n, task_seed("scaling", n, 0));
+            resident_n = n;
+        }
+
+        bool rss_reset = process_memory::reset_peak_rss();
+        BenchmarkStats stats;
+        double result = workload.measure(threads, stats);
+        long long rss_kb = -1, hwm_kb = -1;
+        process_memory::read_status(&rss_kb, &hwm_kb);
+        double peak_rss_mb = rss_reset && hwm_kb >= 0 ? hwm_kb / 1024.0 : -1;
+
+        if (reference_ms < 0) {
+            reference_ms = stats.median_ms;
+            reference_threads = threads;
+        }
+        double speedup = reference_ms / stats.median_ms;
+        double efficiency = scaling == "strong" ? speedup * reference_threads / threads : speedup;
+
+        out << workload.name << "," << scaling << "," << n << "," << threads << ",ok,"
+            << stats.median_ms << "," << stats.ci95_ms << "," << stats.reps << ","
+            << n * 1000.0 / stats.median_ms << "," << speedup << "," << efficiency << ","
+            << peak_rss_mb << "," << estimated_mb << "," << available_mb << "," << result << "\n";
+        std::cout << " " << std::fixed << std::setprecision(1) << stats.median_ms << " ms, efficiency "
+                  << std::setprecision(2)
+                  << efficiency << ", peak RSS " << std::setprecision(0) << peak_rss_mb << " MB\n"
+                  << std::defaultfloat;
+    }
+    workload.release();
+}
+
+/**
+ * @brief Experiment 19: Strong and weak scaling over data size and threads
+ *
+ * Strong scaling: fixed n (users, points sweeps), threads from 1 up to all
+ * cores. Weak scaling: n = users_per_thread / points_per_thread times the
+ * thread count. Inputs are generated on the fly and kept while only the
+ * thread count changes. Sizes run up to 10M users and 100M points by
+ * default, so this experiment only runs when named (make scaling).
+ */
+void experiment_scaling(const std::string& output_file) {
+    std::cout << "Experiment 19: Strong and weak scaling...\n";
+
+    std::ofstream out(output_file);
+    out << "algorithm,scaling,n,threads,status,median_ms,ci95_ms,reps,items_per_sec,speedup,efficiency,"
+        << "peak_rss_mb,estimated_mb,available_mb,result\n";
+
+    const int hw_threads = ThreadPool::hardware_threads();
+    std::vector<int> default_threads;
+    for (int t = 1; t < hw_threads; t *= 2) default_threads.push_back(t);
+    default_threads.push_back(hw_threads);
+    std::vector<int> thread_counts = sweep_values("threads", default_threads);
+
+    auto strong = [&](long long n) {
+        std::vector<std::pair<long long, int>> configs;
+        for (int t : thread_counts) configs.push_back({n, t});
+        return configs;
+    };
+    auto weak = [&](long long per_thread) {
+        std::vector<std::pair<long long, int>> configs;
+        for (int t : thread_counts) configs.push_back({per_thread * t, t});
+        return configs;
+    };
+
+    // Regression: 12 one-column slabs, some narrower than δ, so boundary
+    // strips reach past the adjacent slabs (the true pair is x = 0 vs 0.01)
+    {
+        const double columns[] = {-5, -4, -3, -2, -1, 0, 0.01, 1, 2, 3, 4, 5};
+        const int per_column = 4096, threads = 12;
+        std::vector<Point> points;
+        for (int c = 0; c < 12; ++c) {
+            double offset = c == 5 ? 0.0 : (c == 6 ? 0.5 : 0.04 * c);
+            for (int i = 0; i < per_column; ++i) {
+                points.emplace_back(columns[c], 1000.0 * i + offset, (int)points.size());
+            }
+        }
+        double expected = divide_conquer_closest_pair(points).distance;
+        double got = parallel_closest_pair(points, threads).distance;
+        bool ok = got == expected;
+        out << "closest_pair,regression_narrow_slabs," << points.size() << "," << threads << ","
+            << (ok ? "ok" : "mismatch") << ",-1,-1,-1,-1,-1,-1,-1,-1,-1," << got << "\n";
+        std::cout << "  closest_pair narrow-slab regression: " << (ok ? "ok" : "MISMATCH") << "\n";
+        if (!ok) std::cerr << "  Warning: parallel " << got << " vs sequential " << expected << "\n";
+    }
+
+    GreedyScalingWorkload greedy;
+    for (long long n : sweep_values("users", std::vector<long long>{100000, 1000000, 10000000})) {
+        run_scaling_series(out, greedy, "strong", strong(n));
+    }
+    for (long long n : sweep_values("users_per_thread", std::vector<long long>{250000})) {
+        run_scaling_series(out, greedy, "weak", weak(n));
+    }
+
+    ClosestPairScalingWorkload closest_pair;
+    for (long long n : sweep_values("points", std::vector<long long>{1000000, 10000000, 100000000})) {
+        run_scaling_series(out, closest_pair, "strong", strong(n));
+    }
+    for (long long n : sweep_values("points_per_thread", std::vector<long long>{2000000})) {
+        run_scaling_series(out, closest_pair, "weak", weak(n));
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 20: Sequential vs pipelined generate -> solve -> write
+ *
+ * The same greedy trials (Zipf users, whose generation costs more than the
+ * solve) run once as a plain loop and once through run_pipeline with
+ * --generators generator threads and --jobs solvers. Reports wall time,
+ * busy time per stage, the slowest stage and the median per-trial solve
+ * time of each mode, which should agree when the solvers are pinned.
+ */
+void experiment_pipeline(const std::string& output_file) {
+    std::cout << "Experiment 20: Sequential vs pipelined trial execution...\n";
+
+    std::ofstream out(output_file);
+    out << "n,trials,mode,generators,solvers,wall_ms,generate_busy_ms,solve_busy_ms,write_busy_ms,"
+        << "slowest_stage_ms,solve_median_ms,pinned,mismatches\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{1000, 5000});
+    const int trials = sweep_values("trials", std::vector<int>{40})[0];
+    const int k = 10;
+
+    for (int n : n_values) {
+        std::cout << "  n = " << n << "..." << std::flush;
+
+        auto generate = [&](int t) {
+            DataGenerator gen(task_seed("pipeline", n, t));
+            return gen.generate_zipf(n, 5000, 50, 1.0);
+        };
+        auto solve = [&](int, const std::vector<User>& users) { return greedy_max_coverage(users, k); };
+
+        // Sequential: the three stages one after another on this thread
+        std::vector<CoverageResult> sequential(trials);
+        PipelineStats seq;
+        Timer wall, stage;
+        wall.start();
+        for (int t = 0; t < trials; ++t) {
+            stage.start();
+            auto users = generate(t);
+            seq.generate_busy_ms += stage.elapsed_ms();
+            stage.start();
+            sequential[t] = solve(t, users);
+            seq.solve_busy_ms += stage.elapsed_ms();
+        }
+        seq.wall_ms = wall.elapsed_ms();
+
+        std::vector<CoverageResult> pipelined(trials);
+        PipelineConfig config = pipeline_config(TaskMode::Parallel);
+        PipelineStats pipe = run_pipeline(trials, config, generate, solve,
+            [&](int t, const CoverageResult& r) { pipelined[t] = r; });
+
+        int mismatches = 0;
+        std::vector<double> seq_ms, pipe_ms;
+        for (int t = 0; t < trials; ++t) {
+            if (sequential[t].selected_users != pipelined[t].selected_users) mismatches++;
+            seq_ms.push_back(sequential[t].runtime_ms);
+            pipe_ms.push_back(pipelined[t].runtime_ms);
+        }
+
+        auto row = [&](const char* mode, int generators, int solvers, const PipelineStats& st,
+                       std::vector<double>& solve_ms) {
+            std::sort(solve_ms.begin(), solve_ms.end());
+            double slowest = std::max({st.generate_busy_ms / generators, st.solve_busy_ms / solvers,
+                                       st.write_busy_ms});
+            out << n << "," << trials << "," << mode << "," << generators << "," << solvers << ","
+                << st.wall_ms << "," << st.generate_busy_ms << "," << st.solve_busy_ms << ","
+                << st.write_busy_ms << "," << slowest << "," << benchmark_detail::percentile(solve_ms, 0.5)
+                << "," << st.pinned << "," << mismatches << "\n";
+        };
+        row("sequential", 1, 1, seq, seq_ms);
+        row("pipelined", config.generators, config.solvers, pipe, pipe_ms);
+
+        std::cout << " " << std::fixed << std::setprecision(1) << seq.wall_ms << " -> " << pipe.wall_ms
+                  << " ms wall" << (pipe.pinned ? "" : " (solvers not pinned)") << "\n" << std::defaultfloat;
+        if (mismatches > 0) std::cerr << "  Warning: " << mismatches << " pipelined trials differ\n";
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Generate lat/lon locations in degrees
+ *
+ * - uniform: uniform over the sphere's surface
+ * - antimeridian: 20 city clusters (σ = 0.2°) centred within 1° of
+ *   longitude ±180, so many close pairs straddle the seam
+ */
+std::vector<GeoPoint> generate_geo_points(int n, const std::string& distribution, int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<GeoPoint> points;
+    points.reserve(n);
+
+    if (distribution == "uniform") {
+        for (int i = 0; i < n; ++i) {
+            double lat = std::asin(2 * unit(gen) - 1) * 180.0 / M_PI;
+            points.emplace_back(lat, 360.0 * unit(gen) - 180.0, i);
+        }
+        return points;
+    }
+
+    std::vector<GeoPoint> centers;
+    for (int c = 0; c < 20; ++c) centers.emplace_back(120.0 * unit(gen) - 60.0, 179.0 + 2.0 * unit(gen));
+    std::normal_distribution<double> spread(0.0, 0.2);
+    for (int i = 0; i < n; ++i) {
+        const GeoPoint& c = centers[i % centers.size()];
+        double lon = c.lon + spread(gen);
+        if (lon >= 180.0) lon -= 360.0;     // Wrap into [-180, 180)
+        points.emplace_back(c.lat + spread(gen), lon, i);
+    }
+    return points;
+}
+
+/**
+ * @brief Experiment 21: Geodesic closest pair on lat/lon
+ *
+ * geo_closest_pair (unit vectors + 3D engine) vs a haversine brute force
+ * (up to bf_max points), on uniform and antimeridian-clustered locations.
+ * Also reports the great-circle distance of the pair that plain Euclidean
+ * closest pair on raw (lon, lat) degrees would pick.
+ */
+void experiment_geo_closest_pair(const std::string& output_file) {
+    std::cout << "Experiment 21: Geodesic closest pair (lat/lon)...\n";
+
+    std::ofstream out(output_file);
+    out << "n,distribution,geo_ms,embed_ms,haversine_bf_ms,speedup,distance_m,bf_distance_m,match,"
+        << "degrees_distance_m,comparisons\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{1000, 5000, 10000, 100000});
+    const int bf_max = sweep_values("bf_max", std::vector<int>{10000})[0];
+
+    for (const std::string distribution : {"uniform", "antimeridian"}) {
+        for (int n : n_values) {
+            std::cout << "  " << distribution << ", n = " << n << "..." << std::flush;
+            auto points = generate_geo_points(n, distribution, task_seed("geo_closest_pair", n, 0));
+
+            GeoClosestPairResult geo{}, bf{};
+            BenchmarkStats geo_stats = run_benchmark(options.bench, [] { return 0; },
+                [&](int) { geo = geo_closest_pair(points); });
+
+            double bf_ms = -1;
+            bf.distance_m = -1;
+            if (n <= bf_max) {
+                BenchmarkConfig once = options.bench;
+                once.warmup = 0;
+                once.min_reps = once.max_reps = 1;      // Quadratic: one run is enough
+                bf_ms = run_benchmark(once, [] { return 0; },
+                    [&](int) { bf = haversine_brute_force(points); }).median_ms;
+            }
+            bool match = bf_ms < 0 || std::abs(geo.distance_m - bf.distance_m) <= 1e-9 * bf.distance_m + 1e-6;
+
+            // What treating degrees as planar coordinates would return
+            std::vector<Point> planar;
+            planar.reserve(n);
+            for (const auto& p : points) planar.emplace_back(p.lon, p.lat, p.id);
+            ClosestPairResult naive = divide_conquer_closest_pair(planar);
+            double degrees_m = haversine_m(points[naive.p1.id], points[naive.p2.id]);
+
+            out << n << "," << distribution << "," << geo_stats.median_ms << "," << geo.embed_ms << ","
+                << bf_ms << "," << (bf_ms > 0 ? bf_ms / geo_stats.median_ms : -1) << ","
+                << geo.distance_m << "," << bf.distance_m << "," << match << ","
+                << degrees_m << "," << geo.comparisons << "\n";
+
+            std::cout << " " << std::fixed << std::setprecision(1) << geo.distance_m << " m, "
+                      << std::setprecision(2) << geo_stats.median_ms << " ms"
+                      << (bf_ms >= 0 ? (match ? ", matches brute force" : ", MISMATCH") : "")
+                      << "\n" << std::defaultfloat;
+            if (!match) std::cerr << "  Warning: geo " << geo.distance_m << " m vs brute force "
+                                  << bf.distance_m << " m\n";
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 22: Bichromatic closest pair between two user groups
+ *
+ * Clustered points (50 cities) colored A with probability `ratio`, the rest
+ * B, e.g. drivers and riders in the same cities. bichromatic_closest_pair
+ * vs the |A|·|B| cross loop (while that stays under bf_max_pairs pairs).
+ */
+void experiment_bichromatic_closest_pair(const std::string& output_file) {
+    std::cout << "Experiment 22: Bichromatic closest pair (group A vs group B)...\n";
+
+    std::ofstream out(output_file);
+    out << "n,ratio,size_a,size_b,kd_ms,bf_ms,speedup,distance,bf_distance,match,queries\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{10000, 100000, 1000000});
+    std::vector<double> ratios = sweep_values("ratio", std::vector<double>{0.5, 0.1, 0.01, 0.001});
+    const double bf_max_pairs = sweep_values("bf_max_pairs", std::vector<double>{2e8})[0];
+
+    for (int n : n_values) {
+        auto points = generate_clustered_points(n, 50, 5.0, task_seed("bichromatic_closest_pair", n, 0));
+
+        for (double ratio : ratios) {
+            std::cout << "  n = " << n << ", ratio = " << ratio << "..." << std::flush;
+
+            std::mt19937 color(task_seed("bichromatic_closest_pair", n, 1));
+            std::bernoulli_distribution is_a(ratio);
+            std::vector<Point> a, b;
+            for (const auto& p : points) (is_a(color) ? a : b).push_back(p);
+
+            ClosestPairResult kd, bf;
+            BenchmarkStats kd_stats = run_benchmark(options.bench, [] { return 0; },
+                [&](int) { kd = bichromatic_closest_pair(a, b); });
+
+            double bf_ms = -1;
+            bf.distance = -1;
+            if ((double)a.size() * b.size() <= bf_max_pairs) {
+                BenchmarkConfig once = options.bench;
+                once.warmup = 0;
+                once.min_reps = once.max_reps = 1;      // Quadratic: one run is enough
+                bf_ms = run_benchmark(once, [] { return 0; },
+                    [&](int) { bf = brute_force_bichromatic(a, b); }).median_ms;
+            }
+            bool match = bf_ms < 0 || kd.distance == bf.distance;
+
+            out << n << "," << ratio << "," << a.size() << "," << b.size() << "," << kd_stats.median_ms
+                << "," << bf_ms << "," << (bf_ms > 0 ? bf_ms / kd_stats.median_ms : -1) << ","
+                << kd.distance << "," << bf.distance << "," << match << "," << kd.comparisons << "\n";
+
+            std::cout << " |A| = " << a.size() << ", " << std::fixed << std::setprecision(2)
+                      << kd_stats.median_ms << " ms"
+                      << (bf_ms >= 0 ? (match ? ", matches brute force" : ", MISMATCH") : "")
+                      << "\n" << std::defaultfloat;
+            if (!match) std::cerr << "  Warning: " << kd.distance << " vs brute force " << bf.distance << "\n";
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 23: Anytime greedy under deadlines and cancellation
+ *
+ * single: one query per deadline; how many picks fit, the optimality bound
+ * reached, and how far past the deadline the query returned (deadline -1 =
+ * none, the full greedy run for reference).
+ * async: `queries` concurrent queries on one shared pool, all with the same
+ * deadline. cancel: the same queries without a deadline, all cancelled
+ * after deadline_ms; overshoot is the time from cancel() to the last result.
+ */
+void experiment_anytime_greedy(const std::string& output_file) {
+    std::cout << "Experiment 23: Anytime greedy with deadlines and cancellation...\n";
+
+    std::ofstream out(output_file);
+    out << "mode,n,k,deadline_ms,queries,completed,iterations,coverage,upper_bound,guarantee,"
+        << "runtime_ms,overshoot_ms,wall_ms,prefix_mismatches\n";
+
+    std::vector<int> n_values = sweep_values("n", std::vector<int>{5000});
+    std::vector<double> deadlines = sweep_values("deadline_ms", std::vector<double>{1, 5, 20, 100, 500});
+    const int queries = sweep_values("queries", std::vector<int>{32})[0];
+    const int k = 100;
+    using Clock = AnytimeOptions::Clock;
+    auto ms_since = [](Clock::time_point t) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+    };
+
+    ThreadPool pool;
+
+    for (int n : n_values) {
+        DataGenerator gen(task_seed("anytime_greedy", n, 0));
+        auto users = gen.generate_uniform(n, 5000, 50);
+        CoverageResult full = greedy_max_coverage(users, k);
+
+        // Interrupted runs must return a prefix of the full greedy selection
+        auto prefix_mismatch = [&](const AnytimeCoverageResult& r) {
+            return !std::equal(r.greedy.selected_users.begin(), r.greedy.selected_users.end(),
+                               full.selected_users.begin());
+        };
+        auto write_row = [&](const std::string& mode, double deadline, const std::vector<AnytimeCoverageResult>& rs,
+                             double overshoot, double wall, int mismatches) {
+            double iterations = 0, coverage = 0, bound = 0, guarantee = 0, runtime = 0;
+            int completed = 0, bounded = 0;
+            for (const auto& r : rs) {
+                completed += !r.stopped_early;
+                iterations += r.iterations;
+                coverage += r.greedy.coverage;
+                if (r.upper_bound >= 0) {
+                    bound += r.upper_bound;
+                    bounded++;
+                }
+                guarantee += r.guarantee();
+                runtime += r.greedy.runtime_ms;
+            }
+            double count = rs.size();
+            out << mode << "," << n << "," << k << "," << deadline << "," << rs.size() << "," << completed << ","
+                << iterations / count << "," << coverage / count << "," << (bounded ? bound / bounded : -1) << ","
+                << guarantee / count << "," << runtime / count << "," << overshoot << "," << wall << ","
+                << mismatches << "\n";
+
+            std::cout << "  " << mode << ", n = " << n << ", deadline = " << std::fixed << std::setprecision(1)
+                      << deadline << " ms: " << iterations / count << "/" << k << " picks, "
+                      << std::setprecision(3) << guarantee / count << " of optimum guaranteed, overshoot "
+                      << std::setprecision(2) << overshoot << " ms\n" << std::defaultfloat;
+            if (mismatches) std::cerr << "  Warning: " << mismatches << " results are not a greedy prefix\n";
+        };
+
+        // One query at a time
+        std::vector<double> single_deadlines = deadlines;
+        single_deadlines.insert(single_deadlines.begin(), -1);
+        for (double deadline : single_deadlines) {
+            AnytimeOptions opts = deadline < 0 ? AnytimeOptions() : AnytimeOptions::within(deadline);
+            Clock::time_point start = Clock::now();
+            AnytimeCoverageResult r = greedy_max_coverage_anytime(users, k, opts);
+            double wall = ms_since(start);
+            int mismatches = prefix_mismatch(r) ||
+                             (deadline < 0 && r.greedy.selected_users != full.selected_users);
+            write_row("single", deadline, {r}, deadline < 0 ? 0 : std::max(0.0, wall - deadline), wall, mismatches);
+        }
+
+        // Many queries in flight on the shared pool
+        for (double deadline : deadlines) {
+            Clock::time_point start = Clock::now();
+            AnytimeOptions opts = AnytimeOptions::within(deadline);
+            std::vector<std::future<AnytimeCoverageResult>> futures;
+            for (int q = 0; q < queries; ++q) futures.push_back(greedy_max_coverage_async(pool, users, k, opts));
+
+            std::vector<AnytimeCoverageResult> rs;
+            int mismatches = 0;
+            for (auto& f : futures) {
+                rs.push_back(f.get());
+                mismatches += prefix_mismatch(rs.back());
+            }
+            double wall = ms_since(start);
+            write_row("async", deadline, rs, std::max(0.0, wall - deadline), wall, mismatches);
+        }
+
+        // Cancel in-flight queries
+        for (double deadline : deadlines) {
+            Clock::time_point start = Clock::now();
+            std::vector<CancellationToken> tokens(queries);
+            std::vector<std::future<AnytimeCoverageResult>> futures;
+            for (int q = 0; q < queries; ++q) {
+                AnytimeOptions opts;
+                opts.cancel = tokens[q];
+                futures.push_back(greedy_max_coverage_async(pool, users, k, opts));
+            }
+
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(deadline)));
+            Clock::time_point cancelled = Clock::now();
+            for (auto& token : tokens) token.cancel();
+
+            std::vector<AnytimeCoverageResult> rs;
+            int mismatches = 0;
+            for (auto& f : futures) {
+                rs.push_back(f.get());
+                mismatches += prefix_mismatch(rs.back());
+            }
+            write_row("cancel", deadline, rs, ms_since(cancelled), ms_since(start), mismatches);
+        }
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief Experiment 24: Fingerprint-keyed result caches in front of both engines
+ *
+ * Per size: the uncached call, a miss, a hit with the fingerprint computed
+ * (fingerprint_ms of it) and a hit with the key precomputed. Then a stream
+ * of `queries` requests over `snapshots` instances (skewed towards the
+ * first ones, greedy with random k <= 20) through a cache of `capacity`
+ * entries; uncached_ms_per_query is measured on the first 50 requests.
+ * Every cached answer is checked against a direct run.
+ */
+void experiment_result_cache(const std::string& output_file) {
+    std::cout << "Experiment 24: Result cache keyed by instance fingerprint...\n";
+
+    std::ofstream out(output_file);
+    out << "engine,size,snapshots,capacity,uncached_ms,miss_ms,hit_ms,hit_key_us,fingerprint_ms,"
+        << "queries,hit_rate,evictions,stream_ms_per_query,uncached_ms_per_query,speedup,mismatches\n";
+
+    std::vector<int> user_sizes = sweep_values("users", std::vector<int>{1000, 5000});
+    std::vector<int> point_sizes = sweep_values("points", std::vector<int>{100000, 500000});
+    std::vector<int> capacities = sweep_values("capacity", std::vector<int>{4, 8});
+    const int snapshots = sweep_values("snapshots", std::vector<int>{8})[0];
+    const int queries = sweep_values("queries", std::vector<int>{500})[0];
+    const int k_max = 20;
+    const int hit_reps = 1000;
+
+    // Median of hit_reps calls, in ms
+    auto median_ms = [&](const std::function<void()>& call) {
+        std::vector<double> samples(hit_reps);
+        Timer timer;
+        for (double& s : samples) {
+            timer.start();
+            call();
+            s = timer.elapsed_ms();
+        }
+        std::sort(samples.begin(), samples.end());
+        return benchmark_detail::percentile(samples, 0.5);
+    };
+
+    // Request i of a stream: snapshot skewed towards 0, and k
+    auto request = [&](const std::string& engine, int size, int i) {
+        std::mt19937 rng(task_seed("result_cache_" + engine, size, i));
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        return std::make_pair(std::min(snapshots - 1, (int)(snapshots * u * u)),
+                              std::uniform_int_distribution<int>(1, k_max)(rng));
+    };
+
+    // Run one engine: single-call costs, then one stream per capacity
+    auto run_engine = [&](const std::string& engine, int size, auto& instances, auto direct,
+                          auto make_cache, auto answer, auto same) {
+        std::cout << "  " << engine << ", size = " << size << "..." << std::flush;
+        auto& first = instances[0];
+
+        double uncached_ms = run_benchmark(options.bench, [] { return 0; },
+                                           [&](int) { direct(first, k_max); }).median_ms;
+        auto cache = make_cache(1);
+        Timer timer;
+        timer.start();
+        answer(*cache, first, k_max, 0, false);
+        double miss_ms = timer.elapsed_ms();
+        double hit_ms = median_ms([&] { answer(*cache, first, k_max, 0, false); });
+        const uint64_t key = fingerprint(first);
+        double hit_key_ms = median_ms([&] { answer(*cache, first, k_max, key, true); });
+        double fingerprint_ms = median_ms([&] { fingerprint(first); });
+        std::cout << std::fixed << std::setprecision(3) << " uncached " << uncached_ms << " ms, hit "
+                  << hit_ms << " ms (" << std::setprecision(1) << hit_key_ms * 1000 << " us by key)\n"
+                  << std::defaultfloat;
+
+        std::vector<uint64_t> keys;
+        for (auto& instance : instances) keys.push_back(fingerprint(instance));
+
+        for (int capacity : capacities) {
+            auto stream_cache = make_cache(capacity);
+            int mismatches = 0;
+            Timer stream;
+            stream.start();
+            for (int i = 0; i < queries; ++i) {
+                auto [s, k] = request(engine, size, i);
+                answer(*stream_cache, instances[s], k, keys[s], true);
+            }
+            double stream_ms = stream.elapsed_ms();
+
+            int sampled = std::min(queries, 50);
+            double uncached_stream_ms = 0;
+            for (int i = 0; i < sampled; ++i) {
+                auto [s, k] = request(engine, size, i);
+                timer.start();
+                auto expected = direct(instances[s], k);
+                uncached_stream_ms += timer.elapsed_ms();
+                if (!same(answer(*stream_cache, instances[s], k, keys[s], true), expected)) mismatches++;
+            }
+
+            CacheStats stats = stream_cache->stats();
+            double per_query = stream_ms / queries, uncached_per_query = uncached_stream_ms / sampled;
+            out << engine << "," << size << "," << snapshots << "," << capacity << "," << uncached_ms << ","
+                << miss_ms << "," << hit_ms << "," << hit_key_ms * 1000 << "," << fingerprint_ms << ","
+                << queries << "," << stats.hit_rate() << "," << stats.evictions << "," << per_query << ","
+                << uncached_per_query << "," << uncached_per_query / per_query << "," << mismatches << "\n";
+
+            std::cout << "    capacity = " << capacity << ": hit rate " << std::fixed << std::setprecision(3)
+                      << stats.hit_rate() << ", " << per_query << " ms/query vs " << uncached_per_query
+                      << " uncached\n" << std::defaultfloat;
+            if (mismatches) std::cerr << "  Warning: " << mismatches << " cached answers differ from a direct run\n";
+        }
+    };
+
+    for (int n : user_sizes) {
+        std::vector<std::vector<User>> instances;
+        for (int s = 0; s < snapshots; ++s) {
+            DataGenerator gen(task_seed("result_cache", n, s));
+            instances.push_back(gen.generate_uniform(n, 5000, 50));
+        }
+        run_engine("greedy", n, instances,
+            [](const std::vector<User>& users, int k) { return greedy_max_coverage(users, k); },
+            [&](int capacity) { return std::make_unique<CoverageCache>(capacity, k_max); },
+            [](CoverageCache& cache, const std::vector<User>& users, int k, uint64_t key, bool keyed) {
+                return keyed ? cache.solve(key, users, k) : cache.solve(users, k);
+            },
+            [](const CoverageResult& a, const CoverageResult& b) {
+                return a.selected_users == b.selected_users && a.coverage == b.coverage;
+            });
+    }
+
+    for (int n : point_sizes) {
+        std::vector<std::vector<Point>> instances;
+        for (int s = 0; s < snapshots; ++s) {
+            instances.push_back(generate_uniform_points(n, 0.0, 1000.0, task_seed("result_cache", n, s)));
+        }
+        run_engine("closest_pair", n, instances,
+            [](const std::vector<Point>& points, int) { return divide_conquer_closest_pair(points); },
+            [](int capacity) { return std::make_unique<ClosestPairCache>(capacity); },
+            [](ClosestPairCache& cache, const std::vector<Point>& points, int, uint64_t key, bool keyed) {
+                return keyed ? cache.solve(key, points) : cache.solve(points);
+            },
+            [](const ClosestPairResult& a, const ClosestPairResult& b) { return a.distance == b.distance; });
+    }
+
+    out.close();
+    std::cout << "  Results saved to " << output_file << "\n\n";
+}
+
+/**
+ * @brief A runnable experiment: name (also its output file stem) and entry point
+ */
+struct ExperimentEntry {
+    std::string name;
+    std::string section;
+    std::string description;
+    std::function<void(const std::string&)> run;
+    bool on_demand = false;         // Only runs when named with --only
+};
+
+std::vector<ExperimentEntry> experiment_registry() {
+    const std::string greedy = "GREEDY ALGORITHM EXPERIMENTS";
+    const std::string dc = "DIVIDE & CONQUER EXPERIMENTS";
+    const std::string spatial = "SPATIAL QUERY EXPERIMENTS";
+    const std::string profiling = "PROFILING";
+    const std::string scaling = "SCALING";
+    return {
+        {"runtime_vs_n", greedy, "Greedy runtime vs n (sweep: n)", experiment_runtime_vs_n},
+        {"coverage_vs_k", greedy, "Greedy vs random coverage (sweep: k)", experiment_coverage_vs_k},
+        {"approximation_ratio", greedy, "Greedy vs optimal on small instances", experiment_approximation_ratio},
+        {"zipf_distribution", greedy, "Greedy on Zipf popularity", experiment_zipf_distribution},
+        {"anytime_greedy", greedy, "Deadline / cancellable greedy, single and async (sweep: n, deadline_ms, queries)",
+         experiment_anytime_greedy},
+        {"closest_pair_runtime", dc, "D&C vs brute force runtime (sweep: n)", experiment_closest_pair_runtime},
+        {"closest_pair_distributions", dc, "D&C on uniform / clustered (sweep: n)", experiment_closest_pair_distributions},
+        {"closest_pair_complexity", dc, "D&C runtime vs n log n (sweep: n)", experiment_closest_pair_complexity},
+        {"sort_share", dc, "Sort share of D&C runtime (sweep: n)", experiment_sort_share},
+        {"closest_pair_dimensions", dc, "Per-dimension kernels (sweep: n)", experiment_closest_pair_dimensions},
+        {"morton_closest_pair", dc, "Morton approximate closest pair (sweep: n)", experiment_morton_closest_pair},
+        {"compact_points", dc, "float64 / float32 / fixed-point points (sweep: n)", experiment_compact_points},
+        {"geo_closest_pair", dc, "Great-circle closest pair on lat/lon vs haversine brute force (sweep: n, bf_max)",
+         experiment_geo_closest_pair},
+        {"external_closest_pair", dc, "Out-of-core closest pair (sweep: n, budget_mb)", experiment_external_closest_pair},
+        {"radius_join", spatial, "Fixed-radius join (sweep: n, r, threads)", experiment_radius_join},
+        {"dynamic_closest_pair", spatial, "Dynamic closest pair (sweep: n, batch)", experiment_dynamic_closest_pair},
+        {"knn_graph", spatial, "k-NN graph (sweep: n, k, threads)", experiment_knn_graph},
+        {"spatial_index", spatial, "Subset queries on a prebuilt index (sweep: size)", experiment_spatial_index},
+        {"bichromatic_closest_pair", spatial, "Closest A-B pair vs cross loop (sweep: n, ratio, bf_max_pairs)",
+         experiment_bichromatic_closest_pair},
+        {"batch_instances", spatial, "Batch API vs per-call loop on small instances (sweep: instances)", experiment_batch_instances},
+        {"phase_profile", profiling, "Per-phase time breakdown, needs make TRACE=1 (sweep: n)", experiment_phase_profile},
+        {"pipeline", profiling, "Sequential vs pipelined trials (sweep: n, trials)", experiment_pipeline},
+        {"result_cache", profiling, "Fingerprint-keyed LRU result caches (sweep: users, points, capacity, "
+                                    "snapshots, queries)", experiment_result_cache},
+        {"scaling", scaling, "Strong / weak scaling, on demand (sweep: users, points, threads, "
+                             "users_per_thread, points_per_thread)", experiment_scaling, true},
+    };
+}
+
+/**
+ * @brief Split one CSV line (no quoting is used by the experiments)
+ */
+std::vector<std::string> split_csv_line(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) fields.push_back(field);
+    return fields;
+}
+
+/**
+ * @brief Rewrite a CSV file as a JSON array of objects (numbers unquoted)
+ */
+bool csv_to_json(const std::string& csv_path, const std::string& json_path) {
+    std::ifstream in(csv_path);
+    if (!in) return false;
+
+    auto split = split_csv_line;
+    auto is_number = [](const std::string& v) {
+        if (v.empty()) return false;
+        char* end = nullptr;
+        std::strtod(v.c_str(), &end);
+        return *end == '\0' && v != "inf" && v != "-inf" && v != "nan";
+    };
+
+    std::string line;
+    if (!std::getline(in, line)) return false;
+    std::vector<std::string> header = split(line);
+
+    std::ofstream out(json_path);
+    out << "[";
+    bool first = true;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> fields = split(line);
+        out << (first ? "\n  {" : ",\n  {");
+        first = false;
+        for (size_t i = 0; i < header.size(); ++i) {
+            std::string v = i < fields.size() ? fields[i] : "";
+            out << (i ? ", " : "") << "\"" << header[i] << "\": ";
+            if (is_number(v)) out << v;
+            else out << "\"" << v << "\"";
+        }
+        out << "}";
+    }
+    out << "\n]\n";
+    return true;
+}
+
+// ===============================================
+// PERFORMANCE BASELINES
+// ===============================================
+
+const std::string kBaselineDir = "experiments/baselines/";
+
+/**
+ * @brief A timed quantity in an experiment's CSV: its mean, stddev and reps columns
+ */
+struct TimedMetric {
+    std::string label;
+    std::string mean, stddev, reps;
+};
+
+/**
+ * @brief Row key columns and timed metrics used to compare an experiment
+ */
+struct BaselineSpec {
+    std::vector<std::string> keys;
+    std::vector<TimedMetric> metrics;
+};
+
+/**
+ * @brief Experiments measured with the benchmark harness (others carry no
+ *        spread statistics and are saved but not compared)
+ */
+std::map<std::string, BaselineSpec> baseline_specs() {
+    return {
+        {"runtime_vs_n", {{"n", "k"}, {{"greedy", "avg_runtime_ms", "std_runtime_ms", "reps"}}}},
+        {"closest_pair_runtime", {{"n"}, {{"dc", "dc_runtime_ms", "dc_std_ms", "dc_reps"},
+                                          {"bf", "bf_runtime_ms", "bf_std_ms", "bf_reps"}}}},
+        {"closest_pair_complexity", {{"n"}, {{"dc", "runtime_ms", "std_ms", "reps"}}}},
+    };
+}
+
+/**
+ * @brief A CSV file as header and rows
+ */
+struct CsvTable {
+    std::vector<std::string> header;
+    std::vector<std::vector<std::string>> rows;
+
+    int column(const std::string& name) const {
+        auto it = std::find(header.begin(), header.end(), name);
+        return it == header.end() ? -1 : static_cast<int>(it - header.begin());
+    }
+};
+
+bool read_csv(const std::string& path, CsvTable& table) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line)) return false;
+    table.header = split_csv_line(line);
+    while (std::getline(in, line)) {
+        if (!line.empty()) table.rows.push_back(split_csv_line(line));
+    }
+    return true;
+}
+
+bool copy_file(const std::string& from, const std::string& to) {
+    std::ifstream in(from, std::ios::binary);
+    if (!in) return false;
+    std::ofstream out(to, std::ios::binary);
+    out << in.rdbuf();
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Baseline names become directory names: letters, digits, '.', '_', '-'
+ */
+bool valid_baseline_name(const std::string& name) {
+    if (name.empty() || name == "." || name == "..") return false;
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '_' || c == '-';
+    });
+}
+
+/**
+ * @brief Baseline vs current run for one (experiment, key, metric) point
+ */
+struct BaselineDiff {
+    std::string experiment, key, metric;
+    double baseline_ms = 0, current_ms = 0;
+    double change = 0;          // current / baseline - 1
+    bool significant = false;   // Welch's t-test at 95%
+    std::string verdict;        // slower, faster or same
+};
+
+/**
+ * @brief Compare the timed metrics of matching rows
+ *
+ * A point is slower (faster) if the means differ significantly and the
+ * relative change exceeds +threshold (-threshold). Rows present on only one
+ * side and metrics that were not measured (reps < 1, e.g. skipped brute
+ * force) are ignored.
+ */
+std::vector<BaselineDiff> compare_tables(const std::string& experiment, const BaselineSpec& spec,
+                                         const CsvTable& baseline, const CsvTable& current,
+                                         double threshold) {
+    auto row_key = [&](const CsvTable& t, const std::vector<std::string>& row) {
+        std::string key;
+        for (const auto& k : spec.keys) {
+            int c = t.column(k);
+            key += (key.empty() ? "" : " ") + k + "=" + (c >= 0 && c < (int)row.size() ? row[c] : "?");
+        }
+        return key;
+    };
+    auto value = [](const CsvTable& t, const std::vector<std::string>& row, const std::string& col) {
+        int c = t.column(col);
+        return (c >= 0 && c < (int)row.size()) ? std::strtod(row[c].c_str(), nullptr) : -1.0;
+    };
+
+    std::map<std::string, const std::vector<std::string>*> base_rows;
+    for (const auto& row : baseline.rows) base_rows[row_key(baseline, row)] = &row;
+
+    std::vector<BaselineDiff> diffs;
+    for (const auto& row : current.rows) {
+        std::string key = row_key(current, row);
+        auto it = base_rows.find(key);
+        if (it == base_rows.end()) continue;
+
+        for (const auto& m : spec.metrics) {
+            double base_mean = value(baseline, *it->second, m.mean);
+            double cur_mean = value(current, row, m.mean);
+            int base_reps = static_cast<int>(value(baseline, *it->second, m.reps));
+            int cur_reps = static_cast<int>(value(current, row, m.reps));
+            if (base_reps < 1 || cur_reps < 1 || base_mean <= 0 || cur_mean < 0) continue;
+
+            BaselineDiff d;
+            d.experiment = experiment;
+            d.key = key;
+            d.metric = m.label;
+            d.baseline_ms = base_mean;
+            d.current_ms = cur_mean;
+            d.change = cur_mean / base_mean - 1.0;
+            d.significant = means_differ_95(base_mean, value(baseline, *it->second, m.stddev), base_reps,
+                                            cur_mean, value(current, row, m.stddev), cur_reps);
+            d.verdict = !d.significant ? "same"
+                      : d.change > threshold ? "slower"
+                      : d.change < -threshold ? "faster" : "same";
+            diffs.push_back(d);
+        }
+    }
+    return diffs;
+}
+
+/**
+ * @brief Print the changed points and a summary; write every point to report_path
+ * @return Number of slower points
+ */
+int report_baseline_diffs(const std::string& name, const std::vector<BaselineDiff>& diffs,
+                          double threshold, const std::string& report_path) {
+    std::ofstream out(report_path);
+    out << "experiment,key,metric,baseline_ms,current_ms,change_pct,significant,verdict\n";
+
+    int slower = 0, faster = 0;
+    std::cout << "\n===== BASELINE COMPARISON (" << name << ", threshold "
+              << threshold * 100 << "%) =====\n\n";
+    for (const auto& d : diffs) {
+        out << d.experiment << "," << d.key << "," << d.metric << "," << d.baseline_ms << ","
+            << d.current_ms << "," << d.change * 100 << "," << (d.significant ? 1 : 0) << ","
+            << d.verdict << "\n";
+
+        if (d.verdict == "same") continue;
+        (d.verdict == "slower" ? slower : faster)++;
+        std::cout << "  " << (d.verdict == "slower" ? "SLOWER " : "faster ") << std::left
+                  << std::setw(26) << d.experiment << std::setw(14) << d.key << std::setw(8)
+                  << d.metric << std::right << std::fixed << std::setprecision(3)
+                  << d.baseline_ms << " -> " << d.current_ms << " ms ("
+                  << std::showpos << std::setprecision(1) << d.change * 100 << "%"
+                  << std::noshowpos << ")\n";
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+
+    std::cout << "  " << diffs.size() << " points compared: " << slower << " slower, "
+              << faster << " faster, " << diffs.size() - slower - faster << " unchanged\n"
+              << "  Report saved to " << report_path << "\n\n";
+    return slower;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --list                    List experiments and exit\n"
+              << "  --only a,b,...            Run only the named experiments\n"
+              << "  --sweep key=v1,v2,...     Override a sweep parameter (repeatable)\n"
+              << "  --format csv|json         Output format (default csv)\n"
+              << "  --warmup N                Untimed warmup runs (default 2)\n"
+              << "  --min-reps N              Minimum measured runs (default 5)\n"
+              << "  --max-reps N              Maximum measured runs (default 50)\n"
+              << "  --ci X                    Target relative 95% CI half-width (default 0.02)\n"
+              << "  --max-time-ms X           Time budget per measurement (default 5000)\n"
+              << "  --pin CPU                 Pin the process to one CPU\n"
+              << "  --jobs N                  Run independent trials on N threads (default 1, 0 = all)\n"
+              << "  --no-isolate              Also run timing-sensitive trials in parallel\n"
+              << "  --pipeline                Generate, solve and write trials concurrently\n"
+              << "  --generators N            Generator threads under --pipeline (default 1)\n"
+              << "  --no-counters             Do not record hardware performance counters\n"
+              << "  --save-baseline NAME      Save the results under experiments/baselines/NAME\n"
+              << "  --compare NAME            Compare timings with a saved baseline (exit 2 on slowdown)\n"
+              << "  --threshold X             Relative change reported by --compare (default 0.05)\n";
+}
+
+/**
+ * @brief Parse the command line into options; returns false on error
+ */
+bool parse_args(int argc, char** argv, std::vector<std::string>& only, bool& list) {
+    auto split_list = [](const std::string& v) {
+        std::vector<std::string> items;
+        std::stringstream ss(v);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(arg + " needs a value");
+            return argv[++i];
+        };
+
+        try {
+            if (arg == "--list") {
+                list = true;
+            } else if (arg == "--only") {
+                for (const auto& name : split_list(value())) only.push_back(name);
+            } else if (arg == "--sweep") {
+                std::string spec = value();
+                size_t eq = spec.find('=');
+                if (eq == std::string::npos || eq == 0) {
+                    throw std::invalid_argument("--sweep expects key=v1,v2,...");
+                }
+                std::vector<double> values;
+                for (const auto& v : split_list(spec.substr(eq + 1))) values.push_back(std::stod(v));
+                if (values.empty()) throw std::invalid_argument("--sweep has no values");
+                options.sweeps[spec.substr(0, eq)] = values;
+            } else if (arg == "--format") {
+                options.format = value();
+                if (options.format != "csv" && options.format != "json") {
+                    throw std::invalid_argument("--format must be csv or json");
+                }
+            } else if (arg == "--warmup") {
+                options.bench.warmup = std::stoi(value());
+            } else if (arg == "--min-reps") {
+                options.bench.min_reps = std::stoi(value());
+            } else if (arg == "--max-reps") {
+                options.bench.max_reps = std::stoi(value());
+            } else if (arg == "--ci") {
+                options.bench.target_rel_ci = std::stod(value());
+            } else if (arg == "--max-time-ms") {
+                options.bench.max_time_ms = std::stod(value());
+            } else if (arg == "--pin") {
+                options.pin_cpu = std::stoi(value());
+            } else if (arg == "--jobs") {
+                options.jobs = std::stoi(value());
+                if (options.jobs < 0) throw std::invalid_argument("--jobs must be >= 0");
+            } else if (arg == "--no-isolate") {
+                options.isolate = false;
+            } else if (arg == "--pipeline") {
+                options.pipeline = true;
+            } else if (arg == "--generators") {
+                options.generators = std::stoi(value());
+                if (options.generators < 1) throw std::invalid_argument("--generators must be >= 1");
+            } else if (arg == "--save-baseline" || arg == "--compare") {
+                std::string name = value();
+                if (!valid_baseline_name(name)) {
+                    throw std::invalid_argument("invalid baseline name " + name);
+                }
+                (arg == "--compare" ? options.compare_baseline : options.save_baseline) = name;
+            } else if (arg == "--threshold") {
+                options.threshold = std::stod(value());
+                if (options.threshold < 0) throw std::invalid_argument("--threshold must be >= 0");
+            } else if (arg == "--no-counters") {
+                options.counters = false;
+            } else if (arg == "--help" || arg == "-h") {
+                print_usage(argv[0]);
+                std::exit(0);
+            } else {
+                throw std::invalid_argument("unknown option " + arg);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> only;
+    bool list = false;
+    if (!parse_args(argc, argv, only, list)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<ExperimentEntry> registry = experiment_registry();
+
+    if (list) {
+        for (const auto& e : registry) {
+            std::cout << std::left << std::setw(28) << e.name << e.description
+                      << (e.on_demand ? " [--only]" : "") << "\n";
+        }
+        return 0;
+    }
+
+    for (const auto& name : only) {
+        bool known = std::any_of(registry.begin(), registry.end(),
+            [&](const ExperimentEntry& e) { return e.name == name; });
+        if (!known) {
+            std::cerr << "Error: unknown experiment " << name << " (see --list)\n";
+            return 1;
+        }
+    }
+
+    print_header();
+
+    if (options.pin_cpu >= 0) {
+        if (pin_to_cpu(options.pin_cpu)) {
+            std::cout << "Pinned to CPU " << options.pin_cpu << "\n";
+        } else {
+            std::cerr << "Warning: could not pin to CPU " << options.pin_cpu << "\n";
+        }
+    }
+
+    PerfCounters::set_enabled(options.counters);
+    if (!PerfCounters::enabled()) {
+        std::cout << "Hardware counters: disabled\n";
+    } else if (PerfCounters::available()) {
+        std::cout << "Hardware counters: enabled\n";
+    } else {
+        std::cout << "Hardware counters: unavailable (perf_event_open failed), columns are -1\n";
+    }
+    scheduler.configure(options.jobs, options.isolate);
+    if (scheduler.jobs() > 1) {
+        std::cout << "Parallel trials: " << scheduler.jobs() << " threads, timed trials "
+                  << (scheduler.isolation() ? "isolated" : "not isolated") << "\n";
+    }
+    if (options.pipeline) {
+        std::cout << "Pipelined trials: " << options.generators << " generator(s), "
+                  << scheduler.jobs() << " solver(s), 1 writer\n";
+    }
+    std::cout << "Allocation tracking: "
+              << (AllocTracker::enabled() ? "enabled" : "off (build with make TRACK_ALLOC=1), columns are -1")
+              << "\n";
+
+    // Create output directory if it doesn't exist
+    system("mkdir -p experiments/data");
+    if (!options.save_baseline.empty()) {
+        system(("mkdir -p " + kBaselineDir + options.save_baseline).c_str());
+    }
+    if (!options.compare_baseline.empty() && !std::ifstream(kBaselineDir + options.compare_baseline)) {
+        std::cerr << "Error: no baseline " << kBaselineDir << options.compare_baseline << "\n";
+        return 1;
+    }
+
+    std::map<std::string, BaselineSpec> specs = baseline_specs();
+    std::vector<BaselineDiff> diffs;
+
+    std::string section;
+    for (const auto& e : registry) {
+        bool named = std::find(only.begin(), only.end(), e.name) != only.end();
+        if (only.empty() ? e.on_demand : !named) continue;
+
+        if (e.section != section) {
+            section = e.section;
+            std::cout << "\n===== " << section << " =====\n\n";
+        }
+
+        std::string csv_path = "experiments/data/" + e.name + ".csv";
+        e.run(csv_path);
+
+        if (!options.save_baseline.empty()) {
+            std::string saved = kBaselineDir + options.save_baseline + "/" + e.name + ".csv";
+            if (!copy_file(csv_path, saved)) std::cerr << "Warning: could not save " << saved << "\n";
+        }
+
+        auto spec = specs.find(e.name);
+        if (!options.compare_baseline.empty() && spec != specs.end()) {
+            CsvTable baseline, current;
+            std::string base_path = kBaselineDir + options.compare_baseline + "/" + e.name + ".csv";
+            if (!read_csv(base_path, baseline)) {
+                std::cerr << "Warning: baseline has no " << e.name << ", not compared\n";
+            } else if (read_csv(csv_path, current)) {
+                auto d = compare_tables(e.name, spec->second, baseline, current, options.threshold);
+                diffs.insert(diffs.end(), d.begin(), d.end());
+            }
+        }
+
+        if (options.format == "json") {
+            std::string json_path = "experiments/data/" + e.name + ".json";
+            if (csv_to_json(csv_path, json_path)) {
+                std::remove(csv_path.c_str());
+                std::cout << "  Converted to " << json_path << "\n\n";
+            }
+        }
+    }
+
+    int slower = 0;
+    if (!options.save_baseline.empty()) {
+        std::cout << "Baseline saved to " << kBaselineDir << options.save_baseline << "/\n";
+    }
+    if (!options.compare_baseline.empty()) {
+        slower = report_baseline_diffs(options.compare_baseline, diffs, options.threshold,
+                                       "experiments/data/baseline_" + options.compare_baseline + "_diff.csv");
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "All experiments completed!\n";
+    std::cout << "Results saved in experiments/data/\n";
+    std::cout << "Run Python scripts to generate plots.\n";
+    std::cout << "========================================\n";
+
+    if (slower > 0) {
+        std::cerr << "Performance regression: " << slower << " point(s) slower than baseline "
+                  << options.compare_baseline << "\n";
+        return 2;
+    }
     return 0;
 }
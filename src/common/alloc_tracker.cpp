@@ -0,0 +1,89 @@
+/**
+ * @brief Counting replacements for the global operator new/delete
+ *
+ * Only built with make TRACK_ALLOC=1. Every block carries a header with
+ * its requested size so delete can update the live-byte count without
+ * relying on malloc internals. Over-aligned new/delete (align_val_t) keep
+ * their default implementations and are not counted.
+ */
+#ifdef TRACK_ALLOC
+
+#include "alloc_tracker.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<long long> g_allocations{0};
+std::atomic<long long> g_bytes{0};
+std::atomic<long long> g_live{0};
+std::atomic<long long> g_peak{0};
+
+// Keeps the returned pointer aligned like malloc's
+constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+void* tracked_alloc(std::size_t size) noexcept {
+    void* raw = std::malloc(size + kHeader);
+    if (!raw) return nullptr;
+    *static_cast<std::size_t*>(raw) = size;
+
+    const long long bytes = static_cast<long long>(size);
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    long long live = g_live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    long long peak = g_peak.load(std::memory_order_relaxed);
+    while (live > peak && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+    return static_cast<char*>(raw) + kHeader;
+}
+
+void tracked_free(void* p) noexcept {
+    if (!p) return;
+    char* raw = static_cast<char*>(p) - kHeader;
+    g_live.fetch_sub(static_cast<long long>(*reinterpret_cast<std::size_t*>(raw)),
+                     std::memory_order_relaxed);
+    std::free(raw);
+}
+
+void* tracked_alloc_or_throw(std::size_t size) {
+    void* p = tracked_alloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+} // namespace
+
+namespace alloc_tracker {
+
+long long allocations() { return g_allocations.load(std::memory_order_relaxed); }
+long long bytes_allocated() { return g_bytes.load(std::memory_order_relaxed); }
+long long live_bytes() { return g_live.load(std::memory_order_relaxed); }
+
+long long exchange_peak(long long value) {
+    return g_peak.exchange(value, std::memory_order_relaxed);
+}
+
+long long raise_peak(long long value) {
+    long long peak = g_peak.load(std::memory_order_relaxed);
+    while (value > peak && !g_peak.compare_exchange_weak(peak, value, std::memory_order_relaxed)) {}
+    return peak;
+}
+
+} // namespace alloc_tracker
+
+void* operator new(std::size_t size) { return tracked_alloc_or_throw(size); }
+void* operator new[](std::size_t size) { return tracked_alloc_or_throw(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return tracked_alloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return tracked_alloc(size); }
+
+void operator delete(void* p) noexcept { tracked_free(p); }
+void operator delete[](void* p) noexcept { tracked_free(p); }
+void operator delete(void* p, std::size_t) noexcept { tracked_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { tracked_free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { tracked_free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { tracked_free(p); }
+
+#endif // TRACK_ALLOC
@@ -0,0 +1,162 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief Heap and resident-memory usage of one algorithm run
+ *
+ * Every field is -1 unless the program was built with allocation tracking
+ * (make TRACK_ALLOC=1), and peak_rss_kb is also -1 if the kernel does not
+ * allow resetting the peak RSS.
+ */
+struct AllocStats {
+    bool valid = false;
+    long long allocations = -1;         // Calls to operator new
+    long long bytes_allocated = -1;     // Total bytes requested
+    long long peak_live_bytes = -1;     // Max live heap bytes above the starting level
+    long long rss_kb = -1;              // Resident set size after the run
+    long long peak_rss_kb = -1;         // Peak resident set size during the run
+};
+
+/**
+ * @brief Process-level memory figures from /proc (Linux; available in every build)
+ */
+namespace process_memory {
+
+/**
+ * @brief Reset VmHWM to the current RSS (Linux >= 4.0)
+ */
+inline bool reset_peak_rss() {
+    std::FILE* f = std::fopen("/proc/self/clear_refs", "w");
+    if (!f) return false;
+    bool ok = std::fputs("5", f) >= 0;
+    return std::fclose(f) == 0 && ok;
+}
+
+/**
+ * @brief VmRSS and VmHWM in kB (left unchanged if unavailable)
+ */
+inline void read_status(long long* rss_kb, long long* hwm_kb) {
+    std::FILE* f = std::fopen("/proc/self/status", "r");
+    if (!f) return;
+    char line[256];
+    while (std::fgets(line, sizeof(line), f)) {
+        if (std::strncmp(line, "VmRSS:", 6) == 0) std::sscanf(line + 6, "%lld", rss_kb);
+        if (std::strncmp(line, "VmHWM:", 6) == 0) std::sscanf(line + 6, "%lld", hwm_kb);
+    }
+    std::fclose(f);
+}
+
+/**
+ * @brief MemAvailable from /proc/meminfo in kB (-1 if unavailable)
+ *
+ * The kernel's estimate of memory that can be allocated without swapping,
+ * page cache that can be dropped included.
+ */
+inline long long available_kb() {
+    long long kb = -1;
+    std::FILE* f = std::fopen("/proc/meminfo", "r");
+    if (!f) return kb;
+    char line[256];
+    while (std::fgets(line, sizeof(line), f)) {
+        if (std::strncmp(line, "MemAvailable:", 13) == 0) std::sscanf(line + 13, "%lld", &kb);
+    }
+    std::fclose(f);
+    return kb;
+}
+
+} // namespace process_memory
+
+#ifdef TRACK_ALLOC
+namespace alloc_tracker {
+
+/**
+ * @brief Process-wide totals maintained by the replacement operator new/delete
+ *        (defined in alloc_tracker.cpp)
+ */
+long long allocations();
+long long bytes_allocated();
+long long live_bytes();
+
+/**
+ * @brief Set the peak-live watermark to `value`; returns the previous watermark
+ */
+long long exchange_peak(long long value);
+
+/**
+ * @brief Raise the peak-live watermark to at least `value`; returns the current one
+ */
+long long raise_peak(long long value);
+
+} // namespace alloc_tracker
+#endif
+
+/**
+ * @brief Allocation counting scope (opt-in, build with make TRACK_ALLOC=1)
+ *
+ * Usage mirrors Timer and PerfCounters:
+ *   AllocTracker memory;
+ *   memory.start();
+ *   ... algorithm ...
+ *   memory.stop();
+ *   result.memory = memory.read();
+ *
+ * With TRACK_ALLOC the global operator new/delete are replaced by counting
+ * versions (alloc_tracker.cpp). Counts are process-wide, so allocations of
+ * helper threads are included, and so are those of anything else running
+ * concurrently. Scopes may nest: the peak watermark is saved on start()
+ * and merged back on stop(). Peak RSS comes from VmHWM in /proc/self/status
+ * after resetting it through /proc/self/clear_refs.
+ *
+ * Without TRACK_ALLOC every call is a no-op.
+ */
+class AllocTracker {
+public:
+    /**
+     * @brief True if the build replaces operator new/delete
+     */
+    static constexpr bool enabled() {
+#ifdef TRACK_ALLOC
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void start() {
+#ifdef TRACK_ALLOC
+        rss_reset = process_memory::reset_peak_rss();
+        base_allocations = alloc_tracker::allocations();
+        base_bytes = alloc_tracker::bytes_allocated();
+        base_live = alloc_tracker::live_bytes();
+        saved_peak = alloc_tracker::exchange_peak(base_live);
+#endif
+    }
+
+    void stop() {
+#ifdef TRACK_ALLOC
+        stats.valid = true;
+        stats.allocations = alloc_tracker::allocations() - base_allocations;
+        stats.bytes_allocated = alloc_tracker::bytes_allocated() - base_bytes;
+        stats.peak_live_bytes = alloc_tracker::raise_peak(saved_peak) - base_live;
+        if (stats.peak_live_bytes < 0) stats.peak_live_bytes = 0;
+
+        long long hwm = -1;
+        process_memory::read_status(&stats.rss_kb, &hwm);
+        stats.peak_rss_kb = rss_reset ? hwm : -1;
+#endif
+    }
+
+    AllocStats read() const { return stats; }
+
+private:
+    AllocStats stats;
+#ifdef TRACK_ALLOC
+    long long base_allocations = 0, base_bytes = 0, base_live = 0, saved_peak = 0;
+    bool rss_reset = false;
+#endif
+};
+
+#endif // ALLOC_TRACKER_H
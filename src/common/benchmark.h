@@ -0,0 +1,185 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "timer.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/**
+ * @brief Repetition policy for run_benchmark
+ *
+ * After `warmup` untimed runs, measurements repeat until the 95%
+ * confidence interval of the mean is within target_rel_ci of the mean
+ * (after at least min_reps), or max_reps / max_time_ms is reached.
+ */
+struct BenchmarkConfig {
+    int warmup = 2;                 // Untimed runs before measuring
+    int min_reps = 5;               // Measurements before checking convergence
+    int max_reps = 50;              // Hard cap on measurements
+    double target_rel_ci = 0.02;    // Stop when CI half-width <= 2% of the mean
+    double max_time_ms = 5000.0;    // Time budget for the measured runs
+};
+
+/**
+ * @brief Summary of the measured runs (all times in milliseconds)
+ */
+struct BenchmarkStats {
+    int reps = 0;               // Measured runs
+    bool converged = false;     // CI target reached before a cap
+    double mean_ms = 0;
+    double stddev_ms = 0;       // Sample standard deviation
+    double ci95_ms = 0;         // Half-width of the 95% CI of the mean
+    double median_ms = 0;
+    double p90_ms = 0;
+    double p99_ms = 0;
+    double min_ms = 0;
+    double max_ms = 0;
+};
+
+namespace benchmark_detail {
+
+/**
+ * @brief Two-sided 95% Student t critical value for df degrees of freedom
+ */
+inline double t_critical_95(int df) {
+    static const double table[] = {
+        0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df <= 0) return 0;
+    if (df <= 30) return table[df];
+    return df <= 60 ? 2.000 : (df <= 120 ? 1.980 : 1.960);
+}
+
+/**
+ * @brief Nearest-rank percentile of sorted samples (q in [0, 1])
+ */
+inline double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(std::ceil(q * sorted.size()));
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+} // namespace benchmark_detail
+
+/**
+ * @brief Mean, spread, confidence interval and percentiles of samples
+ */
+inline BenchmarkStats summarize(const std::vector<double>& samples_ms) {
+    BenchmarkStats s;
+    s.reps = samples_ms.size();
+    if (samples_ms.empty()) return s;
+
+    std::vector<double> sorted = samples_ms;
+    std::sort(sorted.begin(), sorted.end());
+
+    for (double t : sorted) s.mean_ms += t;
+    s.mean_ms /= s.reps;
+    if (s.reps > 1) {
+        for (double t : sorted) s.stddev_ms += (t - s.mean_ms) * (t - s.mean_ms);
+        s.stddev_ms = std::sqrt(s.stddev_ms / (s.reps - 1));
+        s.ci95_ms = benchmark_detail::t_critical_95(s.reps - 1) * s.stddev_ms / std::sqrt(s.reps);
+    }
+
+    s.median_ms = benchmark_detail::percentile(sorted, 0.5);
+    s.p90_ms = benchmark_detail::percentile(sorted, 0.9);
+    s.p99_ms = benchmark_detail::percentile(sorted, 0.99);
+    s.min_ms = sorted.front();
+    s.max_ms = sorted.back();
+    return s;
+}
+
+/**
+ * @brief Time run(input) with warmups and adaptive repetition
+ *
+ * prepare() builds a fresh input for every run outside the timed region
+ * (data generation and copies are never measured); run(input) is timed
+ * with the monotonic nanosecond Timer.
+ *
+ * Usage:
+ *   auto stats = run_benchmark(config,
+ *       [&] { return points; },                                  // copy, untimed
+ *       [](std::vector<Point>& p) { divide_conquer_closest_pair(p); });
+ *
+ * @return Summary statistics of the measured runs
+ */
+template <typename Prepare, typename Run>
+BenchmarkStats run_benchmark(const BenchmarkConfig& config, Prepare prepare, Run run) {
+    for (int i = 0; i < config.warmup; ++i) {
+        auto input = prepare();
+        run(input);
+    }
+
+    std::vector<double> samples;
+    double spent_ms = 0;
+    Timer timer;
+    BenchmarkStats stats;
+
+    while (static_cast<int>(samples.size()) < std::max(1, config.max_reps)) {
+        auto input = prepare();
+        timer.start();
+        run(input);
+        timer.stop();
+
+        double ms = timer.elapsed_ms();
+        samples.push_back(ms);
+        spent_ms += ms;
+
+        if (static_cast<int>(samples.size()) >= config.min_reps) {
+            stats = summarize(samples);
+            if (stats.ci95_ms <= config.target_rel_ci * stats.mean_ms) {
+                stats.converged = true;
+                return stats;
+            }
+        }
+        if (spent_ms >= config.max_time_ms) break;
+    }
+
+    stats = summarize(samples);
+    return stats;
+}
+
+/**
+ * @brief Welch's t-test: do two measured means differ at the 95% level?
+ *
+ * Uses unequal variances with Welch-Satterthwaite degrees of freedom, so it
+ * works directly on the mean / standard deviation / reps reported by
+ * BenchmarkStats. Returns false if either side has fewer than two samples.
+ */
+inline bool means_differ_95(double mean_a, double sd_a, int n_a,
+                            double mean_b, double sd_b, int n_b) {
+    if (n_a < 2 || n_b < 2) return false;
+    double va = sd_a * sd_a / n_a;
+    double vb = sd_b * sd_b / n_b;
+    if (va + vb <= 0) return mean_a != mean_b;
+
+    double t = std::fabs(mean_a - mean_b) / std::sqrt(va + vb);
+    double df = (va + vb) * (va + vb) /
+                (va * va / (n_a - 1) + vb * vb / (n_b - 1));
+    return t > benchmark_detail::t_critical_95(static_cast<int>(df));
+}
+
+/**
+ * @brief Pin the calling thread to one CPU (reduces migration noise)
+ *
+ * @return false if pinning is unsupported or the CPU is unavailable
+ */
+inline bool pin_to_cpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+#endif // BENCHMARK_H
@@ -0,0 +1,65 @@
+#ifndef FINGERPRINT_H
+#define FINGERPRINT_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Streaming 64-bit content hash of an instance
+ *
+ * One multiply-rotate-multiply round per 64-bit word (the xxHash64 round)
+ * and a splitmix64 finalizer over the state and the word count. Order
+ * matters: add(a), add(b) and add(b), add(a) give different digests. For
+ * unordered content (a user's location set) combine mix() of each element
+ * with + and add the sum.
+ *
+ * Not cryptographic: it tells snapshots apart, it does not resist crafted
+ * collisions.
+ */
+class Fingerprinter {
+private:
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+
+    uint64_t state = 0x27D4EB2F165667C5ULL;
+    uint64_t words = 0;
+
+    static uint64_t rotl(uint64_t v, int r) {
+        return (v << r) | (v >> (64 - r));
+    }
+
+public:
+    /**
+     * @brief splitmix64 finalizer: full avalanche of one word
+     */
+    static uint64_t mix(uint64_t v) {
+        v ^= v >> 30;
+        v *= 0xBF58476D1CE4E5B9ULL;
+        v ^= v >> 27;
+        v *= 0x94D049BB133111EBULL;
+        return v ^ (v >> 31);
+    }
+
+    void add(uint64_t v) {
+        state = rotl(state ^ (v * kPrime2), 31) * kPrime1;
+        words++;
+    }
+
+    void add(int64_t v) { add(static_cast<uint64_t>(v)); }
+    void add(int v) { add(static_cast<uint64_t>(static_cast<int64_t>(v))); }
+
+    /**
+     * @brief Hash the bit pattern (so 0.0 and -0.0 differ)
+     */
+    void add(double v) {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        add(bits);
+    }
+
+    uint64_t digest() const {
+        return mix(state ^ mix(words));
+    }
+};
+
+#endif // FINGERPRINT_H
@@ -0,0 +1,107 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Concurrent log-linear latency histogram in nanoseconds
+ *
+ * Values below 16 ns have a bucket each; above, every power of two is
+ * split into 16 equal buckets, so a reported percentile is at most 1/16
+ * (6.25%) above the true value. Recording is a few relaxed atomic adds,
+ * so many threads can share one histogram.
+ */
+class LatencyHistogram {
+private:
+    static constexpr int kSubBits = 4;
+    static constexpr int kSub = 1 << kSubBits;
+    static constexpr int kBuckets = (63 - kSubBits + 1) * kSub;
+
+    std::array<std::atomic<uint64_t>, kBuckets> buckets{};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum_ns{0};
+    std::atomic<int64_t> largest{0};
+
+    static int bucket_of(uint64_t v) {
+        if (v < static_cast<uint64_t>(kSub)) return static_cast<int>(v);
+        int exp = 63 - __builtin_clzll(v);
+        int sub = static_cast<int>((v >> (exp - kSubBits)) & (kSub - 1));
+        return (exp - kSubBits + 1) * kSub + sub;
+    }
+
+    // Largest value that falls into bucket i
+    static int64_t upper_edge(int i) {
+        if (i < kSub) return i;
+        int exp = i / kSub + kSubBits - 1;
+        int sub = i % kSub;
+        uint64_t width = 1ULL << (exp - kSubBits);
+        return static_cast<int64_t>((static_cast<uint64_t>(kSub + sub) << (exp - kSubBits)) + width - 1);
+    }
+
+public:
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(int64_t ns) {
+        uint64_t v = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+        buckets[bucket_of(v)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum_ns.fetch_add(v, std::memory_order_relaxed);
+        int64_t seen = largest.load(std::memory_order_relaxed);
+        while (static_cast<int64_t>(v) > seen &&
+               !largest.compare_exchange_weak(seen, static_cast<int64_t>(v), std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    int64_t max_ns() const { return largest.load(std::memory_order_relaxed); }
+
+    double mean_ns() const {
+        uint64_t n = count();
+        return n > 0 ? static_cast<double>(sum_ns.load(std::memory_order_relaxed)) / n : 0.0;
+    }
+
+    /**
+     * @brief Value at quantile q in [0, 1] (upper edge of its bucket, capped at the max); 0 if empty
+     */
+    int64_t percentile_ns(double q) const {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(q * (n - 1)) + 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                int64_t edge = upper_edge(i);
+                return edge < max_ns() ? edge : max_ns();
+            }
+        }
+        return max_ns();
+    }
+
+    /**
+     * @brief Add another histogram's counts to this one
+     */
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < kBuckets; ++i) {
+            buckets[i].fetch_add(other.buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        total.fetch_add(other.count(), std::memory_order_relaxed);
+        sum_ns.fetch_add(other.sum_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        int64_t v = other.max_ns(), seen = largest.load(std::memory_order_relaxed);
+        while (v > seen && !largest.compare_exchange_weak(seen, v, std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset() {
+        for (auto& b : buckets) b.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        sum_ns.store(0, std::memory_order_relaxed);
+        largest.store(0, std::memory_order_relaxed);
+    }
+};
+
+#endif // LATENCY_HISTOGRAM_H
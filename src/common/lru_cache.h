@@ -0,0 +1,118 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Hit / miss counters of a result cache
+ */
+struct CacheStats {
+    long long hits = 0;
+    long long misses = 0;
+    long long evictions = 0;
+    size_t entries = 0;
+    size_t capacity = 0;
+
+    double hit_rate() const {
+        long long lookups = hits + misses;
+        return lookups > 0 ? static_cast<double>(hits) / lookups : 0.0;
+    }
+};
+
+/**
+ * @brief Bounded least-recently-used map from instance fingerprint to result
+ *
+ * Values are held as shared_ptr<const V>, so a hit hands out the stored
+ * result without copying it and an entry evicted while a caller still
+ * reads it stays alive. All operations take one mutex; the solve on a
+ * miss happens outside it, in the caller.
+ */
+template <typename V>
+class LruCache {
+private:
+    using Entry = std::pair<uint64_t, std::shared_ptr<const V>>;
+
+    size_t capacity_;
+    std::list<Entry> order;         // Front = most recently used
+    std::unordered_map<uint64_t, typename std::list<Entry>::iterator> index;
+    mutable std::mutex mutex;
+    CacheStats counts;
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of entries (at least 1)
+     */
+    explicit LruCache(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {
+        index.reserve(capacity_);
+    }
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    /**
+     * @brief Look up a fingerprint; counts a hit only if usable(value)
+     *
+     * An entry that is present but not usable (e.g. a greedy trace shorter
+     * than the k asked for) counts as a miss and is not promoted.
+     *
+     * @return The stored value, or nullptr on a miss
+     */
+    template <typename Usable>
+    std::shared_ptr<const V> get(uint64_t key, Usable usable) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it == index.end() || !usable(*it->second->second)) {
+            counts.misses++;
+            return nullptr;
+        }
+        order.splice(order.begin(), order, it->second);
+        counts.hits++;
+        return it->second->second;
+    }
+
+    std::shared_ptr<const V> get(uint64_t key) {
+        return get(key, [](const V&) { return true; });
+    }
+
+    /**
+     * @brief Insert or replace the value of a fingerprint, evicting the LRU entry if full
+     */
+    void put(uint64_t key, std::shared_ptr<const V> value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            it->second->second = std::move(value);
+            order.splice(order.begin(), order, it->second);
+            return;
+        }
+        if (order.size() >= capacity_) {
+            index.erase(order.back().first);
+            order.pop_back();
+            counts.evictions++;
+        }
+        order.emplace_front(key, std::move(value));
+        index.emplace(key, order.begin());
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.clear();
+        index.clear();
+    }
+
+    CacheStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        CacheStats s = counts;
+        s.entries = order.size();
+        s.capacity = capacity_;
+        return s;
+    }
+};
+
+#endif // LRU_CACHE_H
@@ -0,0 +1,115 @@
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include "benchmark.h"
+#include "timer.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Keep the compiler from discarding a computed value
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Keep the compiler from caching memory across this point
+ */
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+/**
+ * @brief Sampling policy for measure_kernel
+ */
+struct MicrobenchConfig {
+    int samples = 11;               // Samples per kernel (median reported)
+    double min_sample_ms = 20.0;    // Each sample repeats the call until this long
+    int warmup_calls = 1;           // Untimed calls first (warm caches, page in)
+};
+
+/**
+ * @brief Per-operation cost of one kernel on one input
+ */
+struct MicrobenchResult {
+    std::string kernel;         // e.g. "distance"
+    std::string input;          // e.g. "cache/random"
+    long long ops_per_call = 0;
+    double bytes_per_op = 0;    // Input bytes read per operation (nominal)
+    double ns_per_op = 0;       // Median over samples
+    double min_ns_per_op = 0;
+    double ci95_ns = 0;         // Half-width of the 95% CI of the mean
+    int samples = 0;
+    long long calls = 0;        // Timed calls over all samples
+
+    /**
+     * @brief Effective read bandwidth at the median, in GB/s
+     */
+    double gb_per_s() const { return ns_per_op > 0 ? bytes_per_op / ns_per_op : 0; }
+};
+
+/**
+ * @brief Measure a kernel that performs ops_per_call operations per call
+ *
+ * setup() runs before every call outside the timed region (e.g. reshuffle
+ * the input of an in-place sort); run() is timed on its own with the
+ * nanosecond Timer. Each sample repeats setup + run until the timed total
+ * reaches min_sample_ms, and yields one ns/op value; the result reports the
+ * median and minimum over samples. Kernels should do enough work per call
+ * (microseconds) for the per-call timer overhead to be negligible.
+ */
+template <typename Setup, typename Run>
+MicrobenchResult measure_kernel(const MicrobenchConfig& config, const std::string& kernel,
+                                const std::string& input, long long ops_per_call,
+                                double bytes_per_op, Setup setup, Run run) {
+    MicrobenchResult result;
+    result.kernel = kernel;
+    result.input = input;
+    result.ops_per_call = ops_per_call;
+    result.bytes_per_op = bytes_per_op;
+
+    for (int i = 0; i < config.warmup_calls; ++i) {
+        setup();
+        run();
+        clobber_memory();
+    }
+
+    std::vector<double> ns_per_op;
+    Timer timer;
+    for (int s = 0; s < config.samples; ++s) {
+        long long total_ns = 0, calls = 0;
+        while (calls == 0 || total_ns < config.min_sample_ms * 1e6) {
+            setup();
+            clobber_memory();
+            timer.start();
+            run();
+            clobber_memory();
+            timer.stop();
+            total_ns += timer.elapsed_ns();
+            calls++;
+        }
+        result.calls += calls;
+        ns_per_op.push_back(static_cast<double>(total_ns) / (calls * ops_per_call));
+    }
+
+    BenchmarkStats stats = summarize(ns_per_op);    // Units are ns/op here
+    result.samples = stats.reps;
+    result.ns_per_op = stats.median_ms;
+    result.min_ns_per_op = stats.min_ms;
+    result.ci95_ns = stats.ci95_ms;
+    return result;
+}
+
+/**
+ * @brief measure_kernel without per-call setup
+ */
+template <typename Run>
+MicrobenchResult measure_kernel(const MicrobenchConfig& config, const std::string& kernel,
+                                const std::string& input, long long ops_per_call,
+                                double bytes_per_op, Run run) {
+    return measure_kernel(config, kernel, input, ops_per_call, bytes_per_op, [] {}, run);
+}
+
+#endif // MICROBENCH_H
@@ -0,0 +1,206 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Hardware event counts for one algorithm run
+ *
+ * Every field is -1 when that event could not be counted (no PMU access in
+ * containers, perf_event_paranoid too strict, event not supported by the
+ * CPU or the VM). valid is true if at least one event was counted.
+ */
+struct PerfCounts {
+    bool valid = false;
+    long long cycles = -1;
+    long long instructions = -1;
+    long long l1d_misses = -1;      // L1 data cache read misses
+    long long llc_misses = -1;      // Last-level cache misses
+    long long branch_misses = -1;
+
+    /**
+     * @brief Instructions per cycle, or -1 if either count is missing
+     */
+    double ipc() const {
+        return (cycles > 0 && instructions >= 0) ? static_cast<double>(instructions) / cycles : -1.0;
+    }
+};
+
+/**
+ * @brief Hardware counter scope based on Linux perf_event_open
+ *
+ * Usage mirrors Timer:
+ *   PerfCounters counters;      // opens the events (outside the timed region)
+ *   counters.start();
+ *   ... algorithm ...
+ *   counters.stop();
+ *   result.counters = counters.read();
+ *
+ * Each event is opened on its own (not as a group) so one unsupported
+ * event does not disable the others; when the kernel multiplexes them the
+ * counts are scaled by time_enabled / time_running. Only user-space work
+ * of the calling thread is counted: helper threads of parallel algorithms
+ * are not included.
+ *
+ * Counting is opt-in: until set_enabled(true) is called (run_experiments
+ * does so unless --no-counters is given), or if the events are
+ * unavailable, the constructor opens nothing, every call is a no-op and
+ * read() returns PerfCounts with valid = false. Library callers such as
+ * the query server therefore pay no perf_event_open syscalls per query.
+ */
+class PerfCounters {
+public:
+    static const int kEvents = 5;
+
+    PerfCounters() {
+        for (int i = 0; i < kEvents; ++i) fds[i] = -1;
+        if (!enabled() || !available()) return;
+        for (int i = 0; i < kEvents; ++i) fds[i] = open_event(i);
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * @brief Reset and start all open counters
+     */
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Stop all open counters
+     */
+    void stop() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Counts since the last start()
+     */
+    PerfCounts read() const {
+        PerfCounts counts;
+        long long* fields[kEvents] = {&counts.cycles, &counts.instructions, &counts.l1d_misses,
+                                      &counts.llc_misses, &counts.branch_misses};
+#ifdef __linux__
+        for (int i = 0; i < kEvents; ++i) {
+            if (fds[i] < 0) continue;
+
+            // value, time_enabled, time_running (PERF_FORMAT_TOTAL_TIME_*)
+            std::uint64_t data[3] = {0, 0, 0};
+            if (::read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+
+            double value = static_cast<double>(data[0]);
+            if (data[2] > 0 && data[2] < data[1]) value *= static_cast<double>(data[1]) / data[2];
+            *fields[i] = static_cast<long long>(value);
+            counts.valid = true;
+        }
+#else
+        (void)fields;
+#endif
+        return counts;
+    }
+
+    /**
+     * @brief True if this process can count at least CPU cycles (cached)
+     */
+    static bool available() {
+        static const bool ok = [] {
+            int fd = open_event(0);
+#ifdef __linux__
+            if (fd >= 0) close(fd);
+#endif
+            return fd >= 0;
+        }();
+        return ok;
+    }
+
+    /**
+     * @brief Globally enable or disable counting (disabled by default)
+     */
+    static void set_enabled(bool on) { enabled_flag() = on; }
+    static bool enabled() { return enabled_flag(); }
+
+private:
+    int fds[kEvents];
+
+    static bool& enabled_flag() {
+        static bool on = false;
+        return on;
+    }
+
+    /**
+     * @brief Open event i (cycles, instructions, L1D read misses, LLC misses,
+     *        branch misses) for the calling thread, disabled; -1 on failure
+     */
+    static int open_event(int i) {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch (i) {
+            case 0:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case 1:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case 2:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case 3:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            default:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+        }
+
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+        return fd < 0 ? -1 : static_cast<int>(fd);
+#else
+        (void)i;
+        return -1;
+#endif
+    }
+};
+
+#endif // PERF_COUNTERS_H
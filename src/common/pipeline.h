@@ -0,0 +1,264 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "benchmark.h"
+#include "thread_pool.h"
+#include "timer.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Blocking FIFO with a fixed capacity
+ *
+ * push() waits while the queue is full, so a fast producer can run at most
+ * `capacity` items ahead of its consumer. pop() waits while it is empty and
+ * returns nothing once the queue is closed and drained.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity) : cap(capacity > 0 ? capacity : 1) {}
+
+    /**
+     * @brief Append an item; returns false (item dropped) if the queue is closed
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this] { return closed || items.size() < cap; });
+        if (closed) return false;
+        items.push_back(std::move(item));
+        not_empty.notify_one();
+        return true;
+    }
+
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this] { return closed || !items.empty(); });
+        if (items.empty()) return std::nullopt;
+        T item = std::move(items.front());
+        items.pop_front();
+        not_full.notify_one();
+        return item;
+    }
+
+    /**
+     * @brief No more pushes; wakes every waiting producer and consumer
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+
+private:
+    std::size_t cap;
+    std::deque<T> items;
+    bool closed = false;
+    std::mutex mutex;
+    std::condition_variable not_empty, not_full;
+};
+
+/**
+ * @brief Thread counts and queue bounds of a generate -> solve -> write pipeline
+ */
+struct PipelineConfig {
+    int generators = 1;             // Threads producing instances
+    int solvers = 1;                // Threads running the timed solves
+    std::size_t queue_capacity = 4; // Instances (and results) in flight per queue
+    bool pin = true;                // Give the solvers their own CPUs when possible
+};
+
+/**
+ * @brief Where a pipeline run spent its time (milliseconds)
+ *
+ * Busy times are summed over the threads of a stage. With enough CPUs the
+ * wall time approaches max(stage busy / stage threads), the slowest stage.
+ */
+struct PipelineStats {
+    double wall_ms = 0;
+    double generate_busy_ms = 0;
+    double solve_busy_ms = 0;
+    double write_busy_ms = 0;
+    double solver_wait_ms = 0;      // Solvers idle, waiting for instances
+    bool pinned = false;            // Solvers had dedicated CPUs
+};
+
+namespace pipeline_detail {
+
+/**
+ * @brief CPUs this process may run on (empty if unknown)
+ */
+inline std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &set)) cpus.push_back(c);
+        }
+    }
+#endif
+    return cpus;
+}
+
+/**
+ * @brief Atomic add for doubles (busy-time accumulators)
+ */
+inline void add(std::atomic<double>& total, double ms) {
+    double old = total.load(std::memory_order_relaxed);
+    while (!total.compare_exchange_weak(old, old + ms, std::memory_order_relaxed)) {}
+}
+
+} // namespace pipeline_detail
+
+/**
+ * @brief Run count items through generate -> solve -> write on separate threads
+ *
+ * - generate(i) builds instance i (generator threads claim indices in order)
+ * - solve(i, instance) returns result i (solver threads)
+ * - write(i, result) is called on one writer thread in index order 0, 1, ...
+ *   (results that arrive early are held until their turn)
+ *
+ * The calling thread only waits, so its CPU affinity is never changed.
+ *
+ * Bounded queues between the stages keep at most queue_capacity instances
+ * and results in flight, so generators run ahead of the solvers without
+ * holding the whole sweep in memory.
+ *
+ * Solver timings: the solvers time themselves (the algorithms' own
+ * runtime_ms), never across a queue wait. With pin set and at least
+ * solvers + generators + 1 allowed CPUs, each solver thread is pinned to a
+ * CPU of its own and the other stages to the remaining CPUs, so generation
+ * never preempts a timed solve. Otherwise the threads share the CPUs and
+ * stats.pinned is false. Shared caches and memory bandwidth are still
+ * shared either way.
+ *
+ * An exception in any stage closes the queues and is rethrown here once
+ * every thread has stopped.
+ */
+template <typename Generate, typename Solve, typename Write>
+PipelineStats run_pipeline(int count, const PipelineConfig& config,
+                           Generate generate, Solve solve, Write write) {
+    using Instance = decltype(generate(0));
+    using Result = decltype(solve(0, std::declval<Instance&>()));
+
+    PipelineStats stats;
+    Timer wall;
+    wall.start();
+
+    const int generators = std::max(1, config.generators);
+    const int solvers = std::max(1, config.solvers);
+    std::vector<int> cpus = config.pin ? pipeline_detail::allowed_cpus() : std::vector<int>();
+    stats.pinned = static_cast<int>(cpus.size()) >= solvers + generators + 1;
+
+    BoundedQueue<std::pair<int, Instance>> instances(config.queue_capacity);
+    BoundedQueue<std::pair<int, Result>> results(config.queue_capacity);
+    std::atomic<int> next(0), generators_left(generators), solvers_left(solvers);
+    std::atomic<double> generate_ms(0), solve_ms(0), wait_ms(0), write_ms(0);
+
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto fail = [&] {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+        instances.close();
+        results.close();
+    };
+
+    // CPU layout when pinned: solvers first, then generators, then the writer
+    auto pin = [&](int slot) {
+        if (stats.pinned) pin_to_cpu(cpus[slot]);
+    };
+
+    std::vector<std::thread> threads;
+    for (int g = 0; g < generators; ++g) {
+        threads.emplace_back([&, g] {
+            pin(solvers + g);
+            try {
+                Timer timer;
+                for (int i; (i = next.fetch_add(1)) < count;) {
+                    timer.start();
+                    Instance instance = generate(i);
+                    timer.stop();
+                    pipeline_detail::add(generate_ms, timer.elapsed_ms());
+                    if (!instances.push({i, std::move(instance)})) break;
+                }
+            } catch (...) {
+                fail();
+            }
+            if (--generators_left == 0) instances.close();
+        });
+    }
+
+    for (int s = 0; s < solvers; ++s) {
+        threads.emplace_back([&, s] {
+            pin(s);
+            try {
+                Timer timer;
+                for (;;) {
+                    timer.start();
+                    auto item = instances.pop();
+                    timer.stop();
+                    pipeline_detail::add(wait_ms, timer.elapsed_ms());
+                    if (!item) break;
+
+                    timer.start();
+                    Result result = solve(item->first, item->second);
+                    timer.stop();
+                    pipeline_detail::add(solve_ms, timer.elapsed_ms());
+                    if (!results.push({item->first, std::move(result)})) break;
+                }
+            } catch (...) {
+                fail();
+            }
+            if (--solvers_left == 0) results.close();
+        });
+    }
+
+    // Writer: one thread, emitting in index order
+    threads.emplace_back([&] {
+        pin(solvers + generators);
+        try {
+            std::map<int, Result> early;
+            int expected = 0;
+            Timer timer;
+            while (auto item = results.pop()) {
+                early.emplace(item->first, std::move(item->second));
+                for (auto it = early.begin(); it != early.end() && it->first == expected; it = early.begin()) {
+                    timer.start();
+                    write(expected, it->second);
+                    timer.stop();
+                    pipeline_detail::add(write_ms, timer.elapsed_ms());
+                    early.erase(it);
+                    expected++;
+                }
+            }
+        } catch (...) {
+            fail();
+        }
+    });
+
+    for (auto& t : threads) t.join();
+
+    stats.wall_ms = wall.elapsed_ms();
+    stats.generate_busy_ms = generate_ms;
+    stats.solve_busy_ms = solve_ms;
+    stats.write_busy_ms = write_ms;
+    stats.solver_wait_ms = wait_ms;
+    if (error) std::rethrow_exception(error);
+    return stats;
+}
+
+#endif // PIPELINE_H
@@ -0,0 +1,116 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include "thread_pool.h"
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Deterministic seed for one (experiment, parameter, trial) task
+ *
+ * Depends only on the task's identity, never on scheduling order, so a
+ * task generates the same data whichever worker runs it and whatever the
+ * thread count (FNV-1a of the name, mixed with splitmix64).
+ */
+inline std::uint32_t task_seed(const std::string& experiment, long long param, int trial) {
+    std::uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : experiment) {
+        h = (h ^ c) * 1099511628211ULL;
+    }
+    for (std::uint64_t v : {static_cast<std::uint64_t>(param), static_cast<std::uint64_t>(trial)}) {
+        h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h += 0x9e3779b97f4a7c15ULL;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+    }
+    return static_cast<std::uint32_t>(h >> 32) & 0x7fffffffu;    // Fits the int seed parameters
+}
+
+/**
+ * @brief How a batch of tasks may share the machine
+ */
+enum class TaskMode {
+    Parallel,   // Independent trials whose main output is not a timing
+    Isolated    // Timing-sensitive trials: run one at a time, nothing else running
+};
+
+/**
+ * @brief Runs batches of independent experiment tasks on a thread pool
+ *
+ * map(count, mode, fn) evaluates fn(0) .. fn(count - 1) and returns the
+ * results in index order, so reductions over them (sums, averages) are
+ * bit-identical for any number of jobs. Combined with task_seed, an
+ * experiment's output does not depend on the thread count.
+ *
+ * Isolation: with isolation on, Isolated batches run inline on the
+ * calling thread, one task at a time. map() returns only after all tasks
+ * of a batch are done, so no pool task can be running at that point and
+ * the timed trials have the machine to themselves. With isolation off they
+ * are scheduled like Parallel batches (faster, noisier timings).
+ *
+ * map() must be called from outside the pool (tasks must not call map()).
+ */
+class TaskScheduler {
+public:
+    /**
+     * @param jobs Worker threads (1 = run everything inline, 0 = hardware threads)
+     * @param isolation Run Isolated batches exclusively
+     */
+    explicit TaskScheduler(int jobs = 1, bool isolation = true)
+        : num_jobs(jobs > 0 ? jobs : ThreadPool::hardware_threads()), isolate(isolation) {}
+
+    /**
+     * @brief Change the configuration (drops the pool if the job count changes)
+     */
+    void configure(int jobs, bool isolation) {
+        int n = jobs > 0 ? jobs : ThreadPool::hardware_threads();
+        if (n != num_jobs) pool.reset();
+        num_jobs = n;
+        isolate = isolation;
+    }
+
+    int jobs() const { return num_jobs; }
+    bool isolation() const { return isolate; }
+
+    /**
+     * @brief Evaluate fn(i) for i in [0, count); results in index order
+     *
+     * Exceptions thrown by a task are rethrown here (the first one in index
+     * order) after the whole batch has finished.
+     */
+    template <typename F>
+    auto map(int count, TaskMode mode, F fn) -> std::vector<decltype(fn(0))> {
+        using R = decltype(fn(0));
+        std::vector<R> results;
+        results.reserve(count > 0 ? count : 0);
+
+        bool inline_run = num_jobs <= 1 || count <= 1 || (mode == TaskMode::Isolated && isolate);
+        if (inline_run) {
+            for (int i = 0; i < count; ++i) results.push_back(fn(i));
+            return results;
+        }
+
+        if (!pool) pool = std::make_unique<ThreadPool>(num_jobs);
+        std::vector<std::future<R>> futures;
+        futures.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            futures.push_back(pool->submit([&fn, i] { return fn(i); }));
+        }
+
+        // Wait for every task before rethrowing, so none outlives fn
+        for (auto& f : futures) f.wait();
+        for (auto& f : futures) results.push_back(f.get());
+        return results;
+    }
+
+private:
+    int num_jobs;
+    bool isolate;
+    std::unique_ptr<ThreadPool> pool;
+};
+
+#endif // TASK_SCHEDULER_H
@@ -0,0 +1,188 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads
+ *
+ * Tasks are executed in FIFO order by the first idle worker.
+ * The pool joins all workers on destruction after draining the queue.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping;
+
+    void worker_loop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_threads Number of workers (0 = one per hardware thread)
+     */
+    explicit ThreadPool(int num_threads = 0) : stopping(false) {
+        int n = num_threads > 0 ? num_threads : hardware_threads();
+        workers.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Number of worker threads in the pool
+     */
+    int size() const {
+        return static_cast<int>(workers.size());
+    }
+
+    /**
+     * @brief Enqueue a task and return a future for its result
+     */
+    template <typename F>
+    auto submit(F&& fn) -> std::future<decltype(fn())> {
+        using R = decltype(fn());
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(fn));
+        std::future<R> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace([task] { (*task)(); });
+        }
+        cv.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Number of hardware threads (at least 1)
+     */
+    static int hardware_threads() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n > 0 ? static_cast<int>(n) : 1;
+    }
+};
+
+/**
+ * @brief Run body(i, worker) for every i in [begin, end) on num_threads threads
+ *
+ * Work is handed out dynamically in chunks of `grain` indices through an
+ * atomic counter, so uneven iterations balance across workers. The calling
+ * thread participates as worker 0; with num_threads <= 1 the loop runs inline.
+ *
+ * @param begin First index
+ * @param end One past the last index
+ * @param num_threads Number of threads to use (0 = hardware threads)
+ * @param body Callable taking (index, worker_id)
+ * @param grain Indices claimed per counter increment
+ */
+template <typename Body>
+void parallel_for(long long begin, long long end, int num_threads, Body&& body,
+                  long long grain = 1) {
+    if (begin >= end) return;
+    if (num_threads <= 0) num_threads = ThreadPool::hardware_threads();
+    if (grain < 1) grain = 1;
+
+    long long chunks = (end - begin + grain - 1) / grain;
+    num_threads = static_cast<int>(std::min<long long>(num_threads, chunks));
+
+    if (num_threads <= 1) {
+        for (long long i = begin; i < end; ++i) body(i, 0);
+        return;
+    }
+
+    std::atomic<long long> next(begin);
+    auto run = [&](int worker) {
+        for (;;) {
+            long long lo = next.fetch_add(grain, std::memory_order_relaxed);
+            if (lo >= end) return;
+            long long hi = std::min(end, lo + grain);
+            for (long long i = lo; i < hi; ++i) body(i, worker);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (int t = 1; t < num_threads; ++t) {
+        threads.emplace_back(run, t);
+    }
+    run(0);
+    for (auto& t : threads) t.join();
+}
+
+/**
+ * @brief Run body(i, worker) for every i in [begin, end) on the workers of pool
+ *
+ * Same dynamic chunking as parallel_for, without starting any thread: one
+ * task per pool worker (at most one per chunk) claims chunks until none
+ * are left, and the call returns once every task is done. worker is in
+ * [0, pool.size()). Must not be called from a task running on the same
+ * pool, which could leave every worker waiting on queued tasks.
+ *
+ * @param pool Pool whose workers run the loop
+ * @param begin First index
+ * @param end One past the last index
+ * @param body Callable taking (index, worker_id)
+ * @param grain Indices claimed per counter increment
+ */
+template <typename Body>
+void parallel_for(ThreadPool& pool, long long begin, long long end, Body&& body,
+                  long long grain = 1) {
+    if (begin >= end) return;
+    if (grain < 1) grain = 1;
+
+    long long chunks = (end - begin + grain - 1) / grain;
+    int num_tasks = static_cast<int>(std::min<long long>(pool.size(), chunks));
+
+    std::atomic<long long> next(begin);
+    std::vector<std::future<void>> done;
+    done.reserve(num_tasks);
+    for (int t = 0; t < num_tasks; ++t) {
+        done.push_back(pool.submit([&, t] {
+            for (;;) {
+                long long lo = next.fetch_add(grain, std::memory_order_relaxed);
+                if (lo >= end) return;
+                long long hi = std::min(end, lo + grain);
+                for (long long i = lo; i < hi; ++i) body(i, t);
+            }
+        }));
+    }
+    for (auto& f : done) f.wait();
+    for (auto& f : done) f.get();     // Rethrow the first exception of a task
+}
+
+#endif // THREAD_POOL_H
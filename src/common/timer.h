@@ -4,14 +4,16 @@
 #include <chrono>
 
 /**
- * @brief High-resolution timer for benchmarking
+ * @brief Monotonic nanosecond timer for benchmarking
  *
- * Uses std::chrono for microsecond precision timing.
+ * Uses std::chrono::steady_clock, which never jumps backwards (unlike
+ * high_resolution_clock, which may be the wall clock), and keeps full
+ * nanosecond resolution.
  */
 class Timer {
 private:
-    std::chrono::high_resolution_clock::time_point start_time;
-    std::chrono::high_resolution_clock::time_point end_time;
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point end_time;
     bool running;
 
 public:
@@ -21,7 +23,7 @@ public:
      * @brief Start the timer
      */
     void start() {
-        start_time = std::chrono::high_resolution_clock::now();
+        start_time = std::chrono::steady_clock::now();
         running = true;
     }
 
@@ -29,21 +31,28 @@ public:
      * @brief Stop the timer
      */
     void stop() {
-        end_time = std::chrono::high_resolution_clock::now();
+        end_time = std::chrono::steady_clock::now();
         running = false;
     }
 
+    /**
+     * @brief Get elapsed time in nanoseconds
+     * @return Elapsed time in nanoseconds
+     */
+    long long elapsed_ns() {
+        if (running) {
+            end_time = std::chrono::steady_clock::now();
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end_time - start_time).count();
+    }
+
     /**
      * @brief Get elapsed time in milliseconds
      * @return Elapsed time in milliseconds (double precision)
      */
     double elapsed_ms() {
-        if (running) {
-            end_time = std::chrono::high_resolution_clock::now();
-        }
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
-            end_time - start_time);
-        return duration.count() / 1000.0;  // Convert microseconds to milliseconds
+        return elapsed_ns() / 1e6;
     }
 
     /**
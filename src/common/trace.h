@@ -0,0 +1,220 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "timer.h"
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Phases the engines can attribute time to
+ *
+ * Each phase has a parent in trace_phase_info; times are inclusive (a parent
+ * includes its children) and the flame-style dump derives self time.
+ */
+enum class TracePhase {
+    ClosestPair,        // divide_conquer_closest_pair, whole call
+    CpSort,             // Initial x / y sorts
+    CpRecursion,        // Top-level recursive call
+    CpPartition,        // Splitting points_x / points_y into halves
+    CpBaseCase,         // Brute force on n <= 3
+    CpStripBuild,       // Filtering the strip from points_y
+    CpStripScan,        // Scanning the strip
+    Greedy,             // greedy_max_coverage, whole call
+    GreedyScan,         // Marginal gain evaluation over all candidates
+    GreedyUpdate,       // Adding the winner's locations to the covered set
+    Count
+};
+
+struct TracePhaseInfo {
+    const char* name;
+    int parent;         // Index of the parent phase, -1 for roots
+};
+
+inline const TracePhaseInfo& trace_phase_info(TracePhase phase) {
+    static const TracePhaseInfo info[] = {
+        {"divide_conquer_closest_pair", -1},
+        {"sort", static_cast<int>(TracePhase::ClosestPair)},
+        {"recursion", static_cast<int>(TracePhase::ClosestPair)},
+        {"partition", static_cast<int>(TracePhase::CpRecursion)},
+        {"base_case", static_cast<int>(TracePhase::CpRecursion)},
+        {"strip_build", static_cast<int>(TracePhase::CpRecursion)},
+        {"strip_scan", static_cast<int>(TracePhase::CpRecursion)},
+        {"greedy_max_coverage", -1},
+        {"gain_scan", static_cast<int>(TracePhase::Greedy)},
+        {"update_covered", static_cast<int>(TracePhase::Greedy)},
+    };
+    return info[static_cast<int>(phase)];
+}
+
+/**
+ * @brief One greedy iteration
+ */
+struct GreedyIterationTrace {
+    int iteration;
+    long long candidates_scanned;   // Unselected users evaluated
+    long long gain_evaluations;     // Location lookups in the covered set
+    int best_gain;                  // Marginal gain of the winner
+    int best_user;
+    double elapsed_ms;              // Wall time of the iteration
+};
+
+/**
+ * @brief Everything recorded while a TraceScope is active on a thread
+ *
+ * Phase times are summed over all traced calls; strip statistics are per
+ * recursion depth (depth 0 = the full point set).
+ */
+struct TraceLog {
+    long long phase_ns[static_cast<int>(TracePhase::Count)] = {};
+    long long phase_calls[static_cast<int>(TracePhase::Count)] = {};
+    std::vector<GreedyIterationTrace> greedy_iterations;
+    std::vector<long long> strips_by_depth;         // Number of strips built
+    std::vector<long long> strip_points_by_depth;   // Points in those strips
+
+    void clear() { *this = TraceLog(); }
+
+    void add_strip(int depth, long long points) {
+        if (depth >= static_cast<int>(strips_by_depth.size())) {
+            strips_by_depth.resize(depth + 1, 0);
+            strip_points_by_depth.resize(depth + 1, 0);
+        }
+        strips_by_depth[depth]++;
+        strip_points_by_depth[depth] += points;
+    }
+
+    /**
+     * @brief Inclusive time minus the time of direct children
+     */
+    long long self_ns(TracePhase phase) const {
+        long long self = phase_ns[static_cast<int>(phase)];
+        for (int c = 0; c < static_cast<int>(TracePhase::Count); ++c) {
+            if (trace_phase_info(static_cast<TracePhase>(c)).parent == static_cast<int>(phase)) {
+                self -= phase_ns[c];
+            }
+        }
+        return std::max(0LL, self);
+    }
+
+    /**
+     * @brief "root;child;leaf microseconds" lines (folded stacks, the input
+     *        format of flamegraph.pl / speedscope), self time per phase
+     */
+    void write_folded(std::ostream& out) const {
+        for (int p = 0; p < static_cast<int>(TracePhase::Count); ++p) {
+            if (phase_calls[p] == 0) continue;
+            std::string stack = trace_phase_info(static_cast<TracePhase>(p)).name;
+            for (int q = trace_phase_info(static_cast<TracePhase>(p)).parent; q >= 0;
+                 q = trace_phase_info(static_cast<TracePhase>(q)).parent) {
+                stack = std::string(trace_phase_info(static_cast<TracePhase>(q)).name) + ";" + stack;
+            }
+            out << stack << " " << self_ns(static_cast<TracePhase>(p)) / 1000 << "\n";
+        }
+    }
+};
+
+/**
+ * @brief Hot-path tracing, compiled in only with make TRACE=1 (-DENABLE_TRACE)
+ *
+ * The engines call the TRACE_* macros below; without ENABLE_TRACE they
+ * expand to nothing, so the default build pays no cost. With it, records go
+ * to the TraceLog installed on the calling thread by a TraceScope (nothing
+ * is recorded if no scope is active):
+ *
+ *   TraceLog log;
+ *   {
+ *       TraceScope scope(log);
+ *       divide_conquer_closest_pair(points);
+ *   }
+ *   log.write_folded(std::cout);
+ */
+class TraceScope {
+public:
+    explicit TraceScope(TraceLog& log) : previous(current()) { current() = &log; }
+    ~TraceScope() { current() = previous; }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    /**
+     * @brief Log of the calling thread, or nullptr
+     */
+    static TraceLog*& current() {
+        thread_local TraceLog* log = nullptr;
+        return log;
+    }
+
+    /**
+     * @brief True if the engines were built with tracing
+     */
+    static constexpr bool compiled_in() {
+#ifdef ENABLE_TRACE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    TraceLog* previous;
+};
+
+#ifdef ENABLE_TRACE
+
+/**
+ * @brief Adds the time until stop() (or destruction) to one phase of the
+ *        current log
+ */
+class TracePhaseTimer {
+public:
+    explicit TracePhaseTimer(TracePhase p) : log(TraceScope::current()), phase(p) {
+        if (log) timer.start();
+    }
+    ~TracePhaseTimer() { stop(); }
+
+    void stop() {
+        if (!log) return;
+        timer.stop();
+        log->phase_ns[static_cast<int>(phase)] += timer.elapsed_ns();
+        log->phase_calls[static_cast<int>(phase)]++;
+        log = nullptr;
+    }
+
+    TracePhaseTimer(const TracePhaseTimer&) = delete;
+    TracePhaseTimer& operator=(const TracePhaseTimer&) = delete;
+
+private:
+    TraceLog* log;
+    TracePhase phase;
+    Timer timer;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Time the rest of the enclosing block as `phase`
+#define TRACE_PHASE(phase) TracePhaseTimer TRACE_CONCAT(trace_phase_, __LINE__)(phase)
+
+// Time a span of statements as `phase` (TRACE_END may be omitted at block end)
+#define TRACE_BEGIN(name, phase) TracePhaseTimer name(phase)
+#define TRACE_END(name) name.stop()
+
+// Statement that only exists in tracing builds (counters, records)
+#define TRACE_STMT(...) __VA_ARGS__
+
+// Run the statements with `log` bound to the current TraceLog, if any
+#define TRACE_LOG(log, ...) \
+    do { if (TraceLog* log = TraceScope::current()) { __VA_ARGS__; } } while (0)
+
+#else
+
+#define TRACE_PHASE(phase) ((void)0)
+#define TRACE_BEGIN(name, phase) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_STMT(...)
+#define TRACE_LOG(log, ...) ((void)0)
+
+#endif // ENABLE_TRACE
+
+#endif // TRACE_H
@@ -0,0 +1,54 @@
+#include "batch_closest_pair.h"
+#include "closest_pair_engine.h"
+#include "../common/timer.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Cache-line aligned: workers update their own counters per instance
+struct alignas(64) ClosestPairScratch {
+    ClosestPairEngine<Point> engine{0};
+    std::vector<Point> work;
+    long long comparisons = 0;
+};
+
+} // namespace
+
+BatchClosestPairResult closest_pair_batch(const PointBatch& batch, ThreadPool& pool) {
+    Timer timer;
+    timer.start();
+
+    const int instances = batch.size();
+    const int num_threads = pool.size();
+
+    BatchClosestPairResult result;
+    result.threads = num_threads;
+    result.p1.resize(instances);
+    result.p2.resize(instances);
+    result.distance.assign(instances, std::numeric_limits<double>::infinity());
+    std::vector<ClosestPairScratch> scratch(num_threads);
+
+    parallel_for(pool, 0, instances, [&](long long i, int worker) {
+        int n = batch.num_points(i);
+        if (n < 2) return;
+
+        ClosestPairScratch& s = scratch[worker];
+        const Point* first = batch.points.data() + batch.start[i];
+        s.work.assign(first, first + n);        // Reuses capacity
+        s.engine.reset(n);
+        s.engine.run(s.work);
+
+        result.p1[i] = s.engine.best_a;
+        result.p2[i] = s.engine.best_b;
+        result.distance[i] = std::sqrt(s.engine.best);
+        s.comparisons += s.engine.comparisons;
+    }, 64);
+
+    result.comparisons = 0;
+    for (const auto& s : scratch) result.comparisons += s.comparisons;
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
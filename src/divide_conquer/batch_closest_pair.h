@@ -0,0 +1,69 @@
+#ifndef BATCH_CLOSEST_PAIR_H
+#define BATCH_CLOSEST_PAIR_H
+
+#include "closest_pair.h"
+#include "../common/thread_pool.h"
+#include <vector>
+
+/**
+ * @brief Many small point sets packed into one arena
+ *
+ * Instance i is points[start[i] .. start[i+1]).
+ */
+struct PointBatch {
+    std::vector<Point> points;
+    std::vector<int> start;         // Size instances + 1
+
+    PointBatch() : start(1, 0) {}
+
+    /**
+     * @brief Append an instance
+     * @return Index of the instance in the batch
+     */
+    int add(const std::vector<Point>& instance) {
+        points.insert(points.end(), instance.begin(), instance.end());
+        start.push_back(static_cast<int>(points.size()));
+        return size() - 1;
+    }
+
+    int size() const { return static_cast<int>(start.size()) - 1; }
+    int num_points(int i) const { return start[i + 1] - start[i]; }
+};
+
+/**
+ * @brief Closest pair of every instance of a batch
+ *
+ * Entry i belongs to instance i; distance is infinity (and p1 / p2 are
+ * default points) for instances with fewer than two points.
+ */
+struct BatchClosestPairResult {
+    std::vector<Point> p1, p2;
+    std::vector<double> distance;
+    long long comparisons;          // Over all instances
+    double runtime_ms;              // Whole batch
+    int threads;                    // Pool workers used
+
+    double instances_per_second() const {
+        return runtime_ms > 0 ? distance.size() * 1000.0 / runtime_ms : 0.0;
+    }
+};
+
+/**
+ * @brief divide_conquer_closest_pair over every instance of a batch
+ *
+ * Same distances as calling divide_conquer_closest_pair per instance.
+ * Instances are spread in chunks over the workers of an existing pool, so
+ * no thread is started per call. Each worker owns one ClosestPairEngine
+ * (merge, strip and radix sort buffers) and one work buffer; all of them
+ * only grow, so a worker stops allocating once it has solved its largest
+ * instance. The input arena is only read.
+ *
+ * Time Complexity: O(n log n) per instance of n points
+ * Space Complexity: O(max instance size) per worker
+ *
+ * @param batch Packed instances
+ * @param pool Pool whose workers solve the instances (not one this call runs on)
+ */
+BatchClosestPairResult closest_pair_batch(const PointBatch& batch, ThreadPool& pool);
+
+#endif // BATCH_CLOSEST_PAIR_H
@@ -1,5 +1,9 @@
 #include "divide_conquer/closest_pair.h"
+#include "divide_conquer/radix_sort.h"
 #include "common/timer.h"
+#include "common/perf_counters.h"
+#include "common/alloc_tracker.h"
+#include "common/trace.h"
 #include <algorithm>
 #include <limits>
 #include <vector>
@@ -19,7 +23,7 @@ bool compare_y(const Point& a, const Point& b) {
  * Base case for divide and conquer recursion.
  * Also used for validation against O(n²) baseline.
  */
-ClosestPairResult brute_force_closest_pair_impl(const std::vector<Point>& points, int& comparisons) {
+ClosestPairResult brute_force_closest_pair_impl(const std::vector<Point>& points, long long& comparisons) {
     double min_dist = std::numeric_limits<double>::infinity();
     Point p1, p2;
     int n = points.size();
@@ -53,19 +57,19 @@ ClosestPairResult brute_force_closest_pair_impl(const std::vector<Point>& points
  * Key optimization: For each point, only check next 7 points in y-sorted order.
  * Proof: In a 2*delta x delta rectangle, at most 8 points can fit with min distance > delta.
  *
+ * The strip is filtered from points_y, so it is already in y order and is
+ * not re-sorted here.
+ *
  * @param strip Points in the strip, sorted by y-coordinate
  * @param delta Current minimum distance
  * @param comparisons Counter for number of distance comparisons
  * @return Minimum distance and corresponding pair in the strip
  */
-ClosestPairResult find_strip_closest(std::vector<Point>& strip, double delta, int& comparisons) {
+ClosestPairResult find_strip_closest(std::vector<Point>& strip, double delta, long long& comparisons) {
     double min_dist = delta;
     Point p1, p2;
     int n = strip.size();
 
-    // Sort strip by y-coordinate
-    std::sort(strip.begin(), strip.end(), compare_y);
-
     // For each point, only check next 7 points (proven sufficient)
     for (int i = 0; i < n; ++i) {
         for (int j = i + 1; j < n && (strip[j].y - strip[i].y) < min_dist; ++j) {
@@ -94,20 +98,25 @@ ClosestPairResult find_strip_closest(std::vector<Point>& strip, double delta, in
  * @param points_x Points sorted by x-coordinate
  * @param points_y Points sorted by y-coordinate (maintained for efficiency)
  * @param comparisons Counter for number of distance comparisons
+ * @param depth Recursion depth (0 for the full set), used by tracing
  * @return Closest pair in the given set
  */
 ClosestPairResult closest_pair_recursive(
     std::vector<Point>& points_x,
     std::vector<Point>& points_y,
-    int& comparisons
+    long long& comparisons,
+    int depth = 0
 ) {
     int n = points_x.size();
 
     // Base case: use brute force for small instances
     if (n <= 3) {
+        TRACE_PHASE(TracePhase::CpBaseCase);
         return brute_force_closest_pair_impl(points_x, comparisons);
     }
 
+    TRACE_BEGIN(partition_trace, TracePhase::CpPartition);
+
     // Divide: Find middle point
     int mid = n / 2;
     Point mid_point = points_x[mid];
@@ -125,10 +134,11 @@ ClosestPairResult closest_pair_recursive(
     // Create left and right halves for x
     std::vector<Point> left_x(points_x.begin(), points_x.begin() + mid);
     std::vector<Point> right_x(points_x.begin() + mid, points_x.end());
+    TRACE_END(partition_trace);
 
     // Conquer: Recursively find closest pair in each half
-    ClosestPairResult left_result = closest_pair_recursive(left_x, left_y, comparisons);
-    ClosestPairResult right_result = closest_pair_recursive(right_x, right_y, comparisons);
+    ClosestPairResult left_result = closest_pair_recursive(left_x, left_y, comparisons, depth + 1);
+    ClosestPairResult right_result = closest_pair_recursive(right_x, right_y, comparisons, depth + 1);
 
     // Find minimum from both halves
     ClosestPairResult best_result = (left_result.distance < right_result.distance)
@@ -136,15 +146,19 @@ ClosestPairResult closest_pair_recursive(
     double delta = best_result.distance;
 
     // Combine: Check points in strip around dividing line
+    TRACE_BEGIN(strip_build_trace, TracePhase::CpStripBuild);
     std::vector<Point> strip;
     for (const auto& p : points_y) {
         if (std::abs(p.x - mid_point.x) < delta) {
             strip.push_back(p);
         }
     }
+    TRACE_END(strip_build_trace);
+    TRACE_LOG(log, log->add_strip(depth, strip.size()));
 
     // Find closest pair in strip
     if (!strip.empty()) {
+        TRACE_PHASE(TracePhase::CpStripScan);
         ClosestPairResult strip_result = find_strip_closest(strip, delta, comparisons);
         if (strip_result.distance < best_result.distance) {
             best_result = strip_result;
@@ -157,7 +171,7 @@ ClosestPairResult closest_pair_recursive(
 /**
  * @brief Public interface for divide and conquer closest pair
  */
-ClosestPairResult divide_conquer_closest_pair(std::vector<Point>& points) {
+ClosestPairResult divide_conquer_closest_pair(const std::vector<Point>& points) {
     if (points.size() < 2) {
         // Handle edge case: need at least 2 points
         ClosestPairResult result;
@@ -167,23 +181,38 @@ ClosestPairResult divide_conquer_closest_pair(std::vector<Point>& points) {
         return result;
     }
 
+    AllocTracker memory;
+    PerfCounters counters;
     Timer timer;
+    memory.start();
+    counters.start();
     timer.start();
 
-    int comparisons = 0;
+    TRACE_BEGIN(call_trace, TracePhase::ClosestPair);
+    long long comparisons = 0;
 
-    // Sort points by x and y coordinates (O(n log n))
+    // Sort points by x and y coordinates (LSD radix sort, same order as
+    // compare_x / compare_y)
+    TRACE_BEGIN(sort_trace, TracePhase::CpSort);
     std::vector<Point> points_x = points;
     std::vector<Point> points_y = points;
 
-    std::sort(points_x.begin(), points_x.end(), compare_x);
-    std::sort(points_y.begin(), points_y.end(), compare_y);
+    radix_sort_points(points_x, SortAxis::X);
+    radix_sort_points(points_y, SortAxis::Y);
+    TRACE_END(sort_trace);
 
     // Run divide and conquer
+    TRACE_BEGIN(recursion_trace, TracePhase::CpRecursion);
     ClosestPairResult result = closest_pair_recursive(points_x, points_y, comparisons);
+    TRACE_END(recursion_trace);
+    TRACE_END(call_trace);
 
     timer.stop();
+    counters.stop();
     result.runtime_ms = timer.elapsed_ms();
+    result.counters = counters.read();
+    memory.stop();
+    result.memory = memory.read();
     result.comparisons = comparisons;
 
     return result;
@@ -202,14 +231,22 @@ ClosestPairResult brute_force_closest_pair(const std::vector<Point>& points) {
         return result;
     }
 
+    AllocTracker memory;
+    PerfCounters counters;
     Timer timer;
+    memory.start();
+    counters.start();
     timer.start();
 
-    int comparisons = 0;
+    long long comparisons = 0;
     ClosestPairResult result = brute_force_closest_pair_impl(points, comparisons);
 
     timer.stop();
+    counters.stop();
     result.runtime_ms = timer.elapsed_ms();
+    result.counters = counters.read();
+    memory.stop();
+    result.memory = memory.read();
     result.comparisons = comparisons;
 
     return result;
@@ -1,6 +1,8 @@
 #ifndef CLOSEST_PAIR_H
 #define CLOSEST_PAIR_H
 
+#include "../common/alloc_tracker.h"
+#include "../common/perf_counters.h"
 #include <vector>
 #include <cmath>
 #include <utility>
@@ -23,7 +25,9 @@ struct ClosestPairResult {
     Point p1, p2;           // The two closest points
     double distance;        // Distance between them
     double runtime_ms;      // Runtime in milliseconds
-    int comparisons;        // Number of distance comparisons made
+    long long comparisons;  // Number of distance comparisons made
+    PerfCounts counters;    // Hardware counters (-1 if unavailable)
+    AllocStats memory;      // Heap/RSS usage (-1 unless built with TRACK_ALLOC)
 };
 
 /**
@@ -39,6 +43,25 @@ inline double distance(const Point& p1, const Point& p2) {
     return std::sqrt(dx * dx + dy * dy);
 }
 
+/**
+ * @brief (x, y) and (y, x) lexicographic order
+ */
+bool compare_x(const Point& a, const Point& b);
+bool compare_y(const Point& a, const Point& b);
+
+/**
+ * @brief Closest pair within a strip sorted by y (combine step of the
+ *        divide and conquer)
+ *
+ * Only pairs closer than delta in y are compared. distance stays delta and
+ * p1 / p2 are default points if no pair is closer than delta.
+ *
+ * @param strip Points in the strip, sorted by y-coordinate
+ * @param delta Current minimum distance
+ * @param comparisons Incremented once per distance evaluation
+ */
+ClosestPairResult find_strip_closest(std::vector<Point>& strip, double delta, long long& comparisons);
+
 /**
  * @brief Divide and conquer algorithm for closest pair of points
  *
@@ -58,10 +81,10 @@ inline double distance(const Point& p1, const Point& p2) {
  *
  * Space Complexity: O(n) for auxiliary arrays
  *
- * @param points Vector of 2D points (will be modified - sorted)
+ * @param points Vector of 2D points (not modified: the sorts work on copies)
  * @return ClosestPairResult containing the closest pair
  */
-ClosestPairResult divide_conquer_closest_pair(std::vector<Point>& points);
+ClosestPairResult divide_conquer_closest_pair(const std::vector<Point>& points);
 
 /**
  * @brief Brute force algorithm for closest pair (O(n²))
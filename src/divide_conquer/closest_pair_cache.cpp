@@ -0,0 +1,38 @@
+#include "closest_pair_cache.h"
+#include "../common/fingerprint.h"
+#include "../common/timer.h"
+
+uint64_t fingerprint(const std::vector<Point>& points) {
+    Fingerprinter fp;
+    fp.add(static_cast<uint64_t>(points.size()));
+    for (const Point& p : points) {
+        fp.add(p.x);
+        fp.add(p.y);
+        fp.add(p.id);
+    }
+    return fp.digest();
+}
+
+ClosestPairResult ClosestPairCache::solve(const std::vector<Point>& points) {
+    Timer timer;
+    timer.start();
+    ClosestPairResult result = solve(fingerprint(points), points);
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
+
+ClosestPairResult ClosestPairCache::solve(uint64_t key, const std::vector<Point>& points) {
+    Timer timer;
+    timer.start();
+
+    if (std::shared_ptr<const ClosestPairResult> cached = cache.get(key)) {
+        ClosestPairResult result = *cached;
+        result.runtime_ms = timer.elapsed_ms();
+        return result;
+    }
+
+    ClosestPairResult result = divide_conquer_closest_pair(points);
+    cache.put(key, std::make_shared<const ClosestPairResult>(result));
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
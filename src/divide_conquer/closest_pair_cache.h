@@ -0,0 +1,56 @@
+#ifndef CLOSEST_PAIR_CACHE_H
+#define CLOSEST_PAIR_CACHE_H
+
+#include "closest_pair.h"
+#include "../common/lru_cache.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Content fingerprint of a point set: x, y and id of every point, in order
+ *
+ * Order matters, so the same points shuffled are a different key.
+ *
+ * Time Complexity: O(n)
+ */
+uint64_t fingerprint(const std::vector<Point>& points);
+
+/**
+ * @brief LRU cache of divide_conquer_closest_pair results keyed by point-set fingerprint
+ *
+ * divide_conquer_closest_pair leaves its input untouched (it sorts its own
+ * x- and y-ordered copies), so a miss solves the caller's points directly.
+ *
+ * A hit costs the fingerprint (O(n)) plus one lookup. Callers that query
+ * an unchanged snapshot many times should compute fingerprint(points) once
+ * and use the overload taking it, which makes a hit O(1).
+ */
+class ClosestPairCache {
+private:
+    LruCache<ClosestPairResult> cache;
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of point sets kept
+     */
+    explicit ClosestPairCache(size_t capacity) : cache(capacity) {}
+
+    /**
+     * @brief divide_conquer_closest_pair on points, served from the cache when possible
+     *
+     * On a hit runtime_ms is the time of the lookup; comparisons, counters
+     * and memory are those of the run that filled the entry.
+     */
+    ClosestPairResult solve(const std::vector<Point>& points);
+
+    /**
+     * @brief Same, with the point set's fingerprint computed by the caller
+     */
+    ClosestPairResult solve(uint64_t key, const std::vector<Point>& points);
+
+    CacheStats stats() const { return cache.stats(); }
+    void clear() { cache.clear(); }
+};
+
+#endif // CLOSEST_PAIR_CACHE_H
@@ -0,0 +1,205 @@
+#ifndef CLOSEST_PAIR_ENGINE_H
+#define CLOSEST_PAIR_ENGINE_H
+
+#include "compact_point.h"
+#include "radix_sort.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Packing bound for the strip scan in D dimensions (compile time)
+ *
+ * After both halves are solved with minimum delta, the strip candidates
+ * that follow point p in sweep order (coordinate 1) and lie within delta
+ * of p in every coordinate sit in a box of 2δ (x, across the split) × δ
+ * (sweep) × 2δ (each remaining axis). Each side of the split holds points
+ * pairwise >= δ apart; cutting it into cells of side δ/ceil(sqrt(D)) (cell
+ * diameter < δ) leaves at most one point per cell.
+ *
+ * D = 1: 2, D = 2: 8 (the classic "next 7 points"), D = 3: 32.
+ *
+ * @return Maximum number of points in that box, including p
+ */
+template <int D>
+constexpr int strip_packing_bound() {
+    int s = 1;
+    while (s * s < D) ++s;          // ceil(sqrt(D))
+
+    int per_side = s;               // x: δ wide on each side of the split
+    if (D >= 2) per_side *= s;      // sweep axis: δ
+    for (int k = 2; k < D; ++k) per_side *= 2 * s;   // other axes: 2δ
+    return 2 * per_side;
+}
+
+/**
+ * @brief Allocation-free divide and conquer closest pair over any point type
+ *
+ * Works on every P with a PointTraits specialization (2D compact types and
+ * PointND<D, S>). The recursion splits on coordinate 0, merge-sorts each
+ * half by the sweep coordinate (1, or 0 in one dimension) on the way back
+ * up and scans the strip in sweep order. All distances are squared, in
+ * PointTraits<P>::Dist2.
+ *
+ * Strip scan bound (strip_packing_bound<D>, a compile-time constant):
+ * - D <= 2: every point in the sweep window is inside the packing box, so
+ *   each point checks at most bound - 1 successors (the classic 7)
+ * - D >= 3: the sweep window also holds points far away in the remaining
+ *   coordinates; those are rejected by a per-axis box test, and at most
+ *   bound - 1 box hits can exist, so the scan stops there
+ *
+ * best is the global running minimum. Using it instead of the per-level
+ * delta is safe: a level only has to find pairs closer than anything seen
+ * so far, and both halves are >= best apart internally.
+ */
+template <typename P>
+struct ClosestPairEngine {
+    using Traits = PointTraits<P>;
+    using Dist2 = typename Traits::Dist2;
+    static constexpr int D = Traits::dims;
+    static constexpr int kSweep = D >= 2 ? 1 : 0;
+    static constexpr int kBound = strip_packing_bound<D>();
+
+    std::vector<P> scratch;         // Merge buffer
+    std::vector<P> strip;           // Strip buffer
+    RadixBuffers<P> sort_buffers;   // Working memory of run()'s sort
+    Dist2 best;
+    P best_a, best_b;
+    long long comparisons = 0;
+
+    explicit ClosestPairEngine(std::size_t n)
+        : scratch(n), strip(n), best(std::numeric_limits<Dist2>::max()) {}
+
+    /**
+     * @brief Prepare for another instance of up to n points
+     *
+     * Buffers only grow, so an engine reused across many small instances
+     * stops allocating once it has seen the largest one.
+     */
+    void reset(std::size_t n) {
+        if (scratch.size() < n) {
+            scratch.resize(n);
+            strip.resize(n);
+        }
+        best = std::numeric_limits<Dist2>::max();
+        best_a = best_b = P();
+        comparisons = 0;
+    }
+
+    template <int K>
+    static Dist2 coord(const P& p) {
+        return static_cast<Dist2>(Traits::template get<K>(p));
+    }
+
+    static bool less_sweep(const P& a, const P& b) {
+        auto sa = Traits::template get<kSweep>(a), sb = Traits::template get<kSweep>(b);
+        return sa < sb || (sa == sb && Traits::template get<0>(a) < Traits::template get<0>(b));
+    }
+
+    static bool less_split(const P& a, const P& b) {
+        auto xa = Traits::template get<0>(a), xb = Traits::template get<0>(b);
+        return xa < xb || (xa == xb && Traits::template get<kSweep>(a) < Traits::template get<kSweep>(b));
+    }
+
+    /**
+     * @brief True if |a_k - b_k|² < best for every coordinate k >= 2
+     */
+    template <int... K>
+    bool in_box(const P& a, const P& b, std::integer_sequence<int, K...>) const {
+        return (... && ((coord<K + 2>(a) - coord<K + 2>(b)) *
+                        (coord<K + 2>(a) - coord<K + 2>(b)) < best));
+    }
+
+    void consider(const P& a, const P& b) {
+        comparisons++;
+        Dist2 d2 = squared_distance(a, b);
+        if (d2 < best) {
+            best = d2;
+            best_a = a;
+            best_b = b;
+        }
+    }
+
+    /**
+     * @brief Sort by coordinate 0 (radix, in the engine's reusable buffers) and solve
+     */
+    void run(std::vector<P>& points) {
+        radix_sort_by(points,
+            [](const P& p) { return Traits::template get<0>(p); },
+            less_split, sort_buffers);
+        solve(points.data(), points.size());
+    }
+
+    /**
+     * @brief Solve a[0..n), sorted by coordinate 0; leaves it in sweep order
+     */
+    void solve(P* a, int n) {
+        if (n <= 3) {
+            for (int i = 0; i < n; ++i)
+                for (int j = i + 1; j < n; ++j) consider(a[i], a[j]);
+            std::sort(a, a + n, less_sweep);
+            return;
+        }
+
+        int mid = n / 2;
+        Dist2 mid_x = coord<0>(a[mid]);
+
+        solve(a, mid);
+        solve(a + mid, n - mid);
+
+        // Both halves are now in sweep order: merge them
+        std::merge(a, a + mid, a + mid, a + n, scratch.data(), less_sweep);
+        std::copy(scratch.data(), scratch.data() + n, a);
+
+        // Strip of points closer than sqrt(best) to the dividing plane
+        int m = 0;
+        for (int i = 0; i < n; ++i) {
+            Dist2 dx = coord<0>(a[i]) - mid_x;
+            if (dx * dx < best) strip[m++] = a[i];
+        }
+
+        scan(strip.data(), m);
+    }
+
+    /**
+     * @brief Check the pairs of a strip s[0..m), in sweep order, that can
+     *        still beat best
+     */
+    void scan(const P* s, int m) {
+        for (int i = 0; i < m; ++i) {
+            [[maybe_unused]] int hits = 0;
+            for (int j = i + 1; j < m; ++j) {
+                Dist2 dy = coord<kSweep>(s[j]) - coord<kSweep>(s[i]);
+                if (dy * dy >= best) break;
+
+                if constexpr (D <= 2) {
+                    if (j - i >= kBound) break;
+                    consider(s[i], s[j]);
+                } else {
+                    if (!in_box(s[i], s[j], std::make_integer_sequence<int, D - 2>())) {
+                        continue;
+                    }
+                    consider(s[i], s[j]);
+                    if (++hits >= kBound - 1) break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief scan without the packing cap, for strips whose sides are not
+     *        internally >= best apart (stops on the sweep distance only)
+     */
+    void scan_unbounded(const P* s, int m) {
+        for (int i = 0; i < m; ++i) {
+            for (int j = i + 1; j < m; ++j) {
+                Dist2 dy = coord<kSweep>(s[j]) - coord<kSweep>(s[i]);
+                if (dy * dy >= best) break;
+                consider(s[i], s[j]);
+            }
+        }
+    }
+};
+
+#endif // CLOSEST_PAIR_ENGINE_H
@@ -0,0 +1,101 @@
+#include "closest_pair_nd.h"
+#include "closest_pair_engine.h"
+#include "../common/timer.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+template <int D, typename S>
+ClosestPairResultND<D, S> closest_pair_nd(std::vector<PointND<D, S>>& points) {
+    ClosestPairResultND<D, S> result{};
+    result.distance = std::numeric_limits<double>::infinity();
+    if (points.size() < 2) return result;
+
+    Timer timer;
+    timer.start();
+
+    ClosestPairEngine<PointND<D, S>> engine(points.size());
+    engine.run(points);
+
+    timer.stop();
+    result.p1 = engine.best_a;
+    result.p2 = engine.best_b;
+    result.distance = std::sqrt(static_cast<double>(engine.best));
+    result.runtime_ms = timer.elapsed_ms();
+    result.comparisons = engine.comparisons;
+    return result;
+}
+
+template ClosestPairResultND<1, double> closest_pair_nd(std::vector<PointND<1, double>>&);
+template ClosestPairResultND<2, double> closest_pair_nd(std::vector<PointND<2, double>>&);
+template ClosestPairResultND<3, double> closest_pair_nd(std::vector<PointND<3, double>>&);
+template ClosestPairResultND<4, double> closest_pair_nd(std::vector<PointND<4, double>>&);
+template ClosestPairResultND<1, float> closest_pair_nd(std::vector<PointND<1, float>>&);
+template ClosestPairResultND<2, float> closest_pair_nd(std::vector<PointND<2, float>>&);
+template ClosestPairResultND<3, float> closest_pair_nd(std::vector<PointND<3, float>>&);
+template ClosestPairResultND<4, float> closest_pair_nd(std::vector<PointND<4, float>>&);
+template ClosestPairResultND<2, std::int32_t> closest_pair_nd(std::vector<PointND<2, std::int32_t>>&);
+template ClosestPairResultND<3, std::int32_t> closest_pair_nd(std::vector<PointND<3, std::int32_t>>&);
+
+namespace {
+
+/**
+ * @brief Pack row-major coordinates into PointND<D, S>, solve, unpack
+ */
+template <int D, typename S>
+DispatchedClosestPairResult run_specialized(const std::vector<double>& coords,
+                                            const std::vector<int>& ids) {
+    std::vector<PointND<D, S>> points(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        for (int k = 0; k < D; ++k) {
+            points[i].c[k] = static_cast<S>(coords[i * D + k]);
+        }
+        points[i].id = ids[i];
+    }
+
+    auto nd = closest_pair_nd(points);
+
+    DispatchedClosestPairResult result;
+    result.dims = D;
+    result.id1 = nd.p1.id;
+    result.id2 = nd.p2.id;
+    result.p1.assign(nd.p1.c.begin(), nd.p1.c.end());
+    result.p2.assign(nd.p2.c.begin(), nd.p2.c.end());
+    result.distance = nd.distance;
+    result.runtime_ms = nd.runtime_ms;
+    result.comparisons = nd.comparisons;
+    return result;
+}
+
+template <typename S>
+DispatchedClosestPairResult dispatch_dims(int dims, const std::vector<double>& coords,
+                                          const std::vector<int>& ids) {
+    switch (dims) {
+        case 1: return run_specialized<1, S>(coords, ids);
+        case 2: return run_specialized<2, S>(coords, ids);
+        case 3: return run_specialized<3, S>(coords, ids);
+        case 4: return run_specialized<4, S>(coords, ids);
+        default: break;
+    }
+
+    std::cerr << "Warning: closest pair not specialized for " << dims << " dimensions" << std::endl;
+    DispatchedClosestPairResult result;
+    result.dims = dims;
+    result.id1 = result.id2 = -1;
+    result.distance = std::numeric_limits<double>::infinity();
+    result.runtime_ms = -1;
+    result.comparisons = 0;
+    return result;
+}
+
+} // namespace
+
+DispatchedClosestPairResult closest_pair_any_dim(int dims,
+                                                 const std::vector<double>& coords,
+                                                 const std::vector<int>& ids,
+                                                 PointEncoding encoding) {
+    if (encoding == PointEncoding::Float32) {
+        return dispatch_dims<float>(dims, coords, ids);
+    }
+    return dispatch_dims<double>(dims, coords, ids);
+}
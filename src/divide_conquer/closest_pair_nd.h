@@ -0,0 +1,117 @@
+#ifndef CLOSEST_PAIR_ND_H
+#define CLOSEST_PAIR_ND_H
+
+#include "compact_point.h"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Point in D dimensions with scalar type S
+ *
+ * Examples: PointND<3, double> for (lat, lon, altitude) or a time-scaled
+ * embedding; PointND<3, float> halves the bytes per point.
+ */
+template <int D, typename S>
+struct PointND {
+    std::array<S, D> c;     // Coordinates
+    int id;                 // User ID for tracking
+};
+
+/**
+ * @brief Traits for PointND: exact squared distances for integer scalars
+ *
+ * Integer scalars of up to 16 bits square into int64; 32-bit scalars use
+ * __int128, since a full-range int32 axis delta is up to 2^32 and its
+ * square alone overflows int64.
+ */
+template <int D, typename S>
+struct PointTraits<PointND<D, S>> {
+    static_assert(!std::is_integral<S>::value || sizeof(S) <= 4,
+                  "integer coordinates wider than 32 bits have no exact squared distance");
+    using Scalar = S;
+    using Dist2 = typename std::conditional<
+        std::is_integral<S>::value,
+        typename std::conditional<(sizeof(S) <= 2), std::int64_t, __int128>::type,
+        S>::type;
+    static constexpr int dims = D;
+
+    template <int K>
+    static Scalar get(const PointND<D, S>& p) {
+        static_assert(K >= 0 && K < D, "coordinate index out of range");
+        return p.c[K];
+    }
+};
+
+/**
+ * @brief Result of a D-dimensional closest pair
+ */
+template <int D, typename S>
+struct ClosestPairResultND {
+    PointND<D, S> p1, p2;   // The two closest points
+    double distance;        // Distance between them
+    double runtime_ms;      // Runtime in milliseconds
+    long long comparisons;  // Number of distance comparisons made
+};
+
+/**
+ * @brief Divide and conquer closest pair in D dimensions
+ *
+ * Same engine as compact_closest_pair (ClosestPairEngine), instantiated per
+ * (D, S): the distance kernel is a fold over D coordinates and the strip
+ * packing bound is a compile-time constant (see strip_packing_bound).
+ *
+ * Time Complexity: O(n log n) for D <= 2; for D >= 3 the strip scan also
+ * walks sweep-window points that fail the box test, which is O(n log n)
+ * for spread-out data.
+ *
+ * @param points Points (reordered in place)
+ * @return Closest pair in the input's own units
+ */
+template <int D, typename S>
+ClosestPairResultND<D, S> closest_pair_nd(std::vector<PointND<D, S>>& points);
+
+// Exported instantiations (defined in closest_pair_nd.cpp)
+extern template ClosestPairResultND<1, double> closest_pair_nd(std::vector<PointND<1, double>>&);
+extern template ClosestPairResultND<2, double> closest_pair_nd(std::vector<PointND<2, double>>&);
+extern template ClosestPairResultND<3, double> closest_pair_nd(std::vector<PointND<3, double>>&);
+extern template ClosestPairResultND<4, double> closest_pair_nd(std::vector<PointND<4, double>>&);
+extern template ClosestPairResultND<1, float> closest_pair_nd(std::vector<PointND<1, float>>&);
+extern template ClosestPairResultND<2, float> closest_pair_nd(std::vector<PointND<2, float>>&);
+extern template ClosestPairResultND<3, float> closest_pair_nd(std::vector<PointND<3, float>>&);
+extern template ClosestPairResultND<4, float> closest_pair_nd(std::vector<PointND<4, float>>&);
+extern template ClosestPairResultND<2, std::int32_t> closest_pair_nd(std::vector<PointND<2, std::int32_t>>&);
+extern template ClosestPairResultND<3, std::int32_t> closest_pair_nd(std::vector<PointND<3, std::int32_t>>&);
+
+/**
+ * @brief Result of closest_pair_any_dim
+ */
+struct DispatchedClosestPairResult {
+    int dims;                       // Dimension the kernel was specialized for
+    int id1, id2;                   // Ids of the closest pair
+    std::vector<double> p1, p2;     // Their coordinates
+    double distance;                // Distance between them
+    double runtime_ms;              // Runtime in milliseconds (-1 if unsupported)
+    long long comparisons;          // Number of distance comparisons made
+};
+
+/**
+ * @brief Closest pair for a dimension only known at runtime
+ *
+ * Dispatches to the fully specialized closest_pair_nd<D, S> kernel for
+ * D in 1..4. Unsupported dimensions print a warning and return
+ * runtime_ms = -1.
+ *
+ * @param dims Number of coordinates per point
+ * @param coords Row-major coordinates, size n * dims
+ * @param ids Point ids, size n
+ * @param encoding Float64 (exact) or Float32 (half the bytes per point)
+ * @return Closest pair with coordinates converted back to double
+ */
+DispatchedClosestPairResult closest_pair_any_dim(int dims,
+                                                 const std::vector<double>& coords,
+                                                 const std::vector<int>& ids,
+                                                 PointEncoding encoding = PointEncoding::Float64);
+
+#endif // CLOSEST_PAIR_ND_H
@@ -0,0 +1,73 @@
+#include "compact_closest_pair.h"
+#include "closest_pair_engine.h"
+#include "../common/timer.h"
+#include <cmath>
+#include <limits>
+
+template <typename P>
+ClosestPairResult compact_closest_pair(std::vector<P>& points) {
+    ClosestPairResult result;
+    result.distance = std::numeric_limits<double>::infinity();
+    result.runtime_ms = 0;
+    result.comparisons = 0;
+    if (points.size() < 2) return result;
+
+    Timer timer;
+    timer.start();
+
+    ClosestPairEngine<P> engine(points.size());
+    engine.run(points);
+
+    timer.stop();
+    result.p1 = Point(engine.best_a.x, engine.best_a.y, engine.best_a.id);
+    result.p2 = Point(engine.best_b.x, engine.best_b.y, engine.best_b.id);
+    result.distance = std::sqrt(static_cast<double>(engine.best));
+    result.runtime_ms = timer.elapsed_ms();
+    result.comparisons = engine.comparisons;
+    return result;
+}
+
+template ClosestPairResult compact_closest_pair<Point>(std::vector<Point>&);
+template ClosestPairResult compact_closest_pair<PointF32>(std::vector<PointF32>&);
+template ClosestPairResult compact_closest_pair<PointFixed>(std::vector<PointFixed>&);
+
+ClosestPairResult closest_pair_encoded(const std::vector<Point>& points,
+                                       PointEncoding encoding,
+                                       QuantizationReport* report) {
+    Timer timer;
+    timer.start();
+
+    ClosestPairResult result;
+    switch (encoding) {
+        case PointEncoding::Float32: {
+            auto encoded = encode_float32(points, report);
+            result = compact_closest_pair(encoded);
+            break;
+        }
+        case PointEncoding::Fixed32: {
+            auto encoded = encode_fixed(points, 0.0, report);
+            result = compact_closest_pair(encoded);
+            break;
+        }
+        case PointEncoding::Float64:
+        default: {
+            // Ids become input indices, as for the compact encodings
+            std::vector<Point> copy(points);
+            for (size_t i = 0; i < copy.size(); ++i) copy[i].id = i;
+            if (report) *report = {PointEncoding::Float64, 0.0, 0.0, 1.0, 0.0, 0.0};
+            result = compact_closest_pair(copy);
+            break;
+        }
+    }
+
+    if (points.size() >= 2) {
+        // Map back to the original points and report the exact distance
+        result.p1 = points[result.p1.id];
+        result.p2 = points[result.p2.id];
+        result.distance = distance(result.p1, result.p2);
+    }
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
@@ -0,0 +1,52 @@
+#ifndef COMPACT_CLOSEST_PAIR_H
+#define COMPACT_CLOSEST_PAIR_H
+
+#include "closest_pair.h"
+#include "compact_point.h"
+#include <vector>
+
+/**
+ * @brief Divide and conquer closest pair over a compact point type
+ *
+ * Same recurrence as divide_conquer_closest_pair, restructured so the
+ * working set is the points themselves:
+ * - One x-sort (radix_sort_points) of the input, no points_x/points_y copies
+ * - The recursion merge-sorts each half by y on the way back up
+ *   (T(n) = 2T(n/2) + O(n)), so the strip never needs its own sort
+ * - One scratch buffer and one strip buffer are allocated up front
+ * - All comparisons use squared distances in PointTraits<P>::Dist2, which
+ *   is exact for PointFixed
+ *
+ * With 12-byte PointF32/PointFixed every pass moves half the bytes of the
+ * 24-byte Point.
+ *
+ * Time Complexity: O(n log n)
+ * Space Complexity: O(n) scratch
+ *
+ * @param points Points in the engine's representation (reordered in place)
+ * @return Closest pair; coordinates and distance are in encoded units
+ */
+template <typename P>
+ClosestPairResult compact_closest_pair(std::vector<P>& points);
+
+/**
+ * @brief Closest pair after encoding the input compactly
+ *
+ * Encodes the points (see encode_float32 / encode_fixed), solves on the
+ * compact copy and maps the winning pair back to the original points. The
+ * returned distance is the exact double distance of that pair, which is
+ * within 2·report->max_distance_error (4·sqrt(2)·max_coord_error) of the
+ * true closest distance: the winning pair may be a different one than the
+ * true closest pair, and each of their distances moves by up to
+ * max_distance_error.
+ *
+ * @param points Input points (not modified)
+ * @param encoding Representation to solve in
+ * @param report Optional output describing the quantization error
+ * @return Closest pair in world coordinates; runtime_ms includes encoding
+ */
+ClosestPairResult closest_pair_encoded(const std::vector<Point>& points,
+                                       PointEncoding encoding,
+                                       QuantizationReport* report = nullptr);
+
+#endif // COMPACT_CLOSEST_PAIR_H
@@ -0,0 +1,97 @@
+#include "compact_point.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Fixed-point coordinates stay within [0, 2^30] so squared distances fit int64
+const double kFixedRange = 1 << 30;
+
+struct BoundingBox {
+    double min_x, min_y, max_x, max_y;
+};
+
+BoundingBox bounding_box(const std::vector<Point>& points) {
+    BoundingBox box{0, 0, 0, 0};
+    if (points.empty()) return box;
+
+    box = {points[0].x, points[0].y, points[0].x, points[0].y};
+    for (const auto& p : points) {
+        box.min_x = std::min(box.min_x, p.x);
+        box.min_y = std::min(box.min_y, p.y);
+        box.max_x = std::max(box.max_x, p.x);
+        box.max_y = std::max(box.max_y, p.y);
+    }
+    return box;
+}
+
+double finest_resolution(const BoundingBox& box) {
+    double extent = std::max(box.max_x - box.min_x, box.max_y - box.min_y);
+    return extent > 0 ? extent / kFixedRange : 1.0;
+}
+
+} // namespace
+
+std::vector<PointF32> encode_float32(const std::vector<Point>& points,
+                                     QuantizationReport* report) {
+    BoundingBox box = bounding_box(points);
+    std::vector<PointF32> encoded;
+    encoded.reserve(points.size());
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        float x = static_cast<float>(points[i].x - box.min_x);
+        float y = static_cast<float>(points[i].y - box.min_y);
+        encoded.push_back({x, y, static_cast<int>(i)});
+
+        max_error = std::max(max_error, std::abs(box.min_x + x - points[i].x));
+        max_error = std::max(max_error, std::abs(box.min_y + y - points[i].y));
+    }
+
+    if (report) {
+        *report = {PointEncoding::Float32, box.min_x, box.min_y, 1.0,
+                   max_error, 2 * std::sqrt(2.0) * max_error};
+    }
+    return encoded;
+}
+
+std::vector<PointFixed> encode_fixed(const std::vector<Point>& points,
+                                     double resolution,
+                                     QuantizationReport* report) {
+    BoundingBox box = bounding_box(points);
+    double finest = finest_resolution(box);
+    double scale = std::max(resolution, finest);
+
+    std::vector<PointFixed> encoded;
+    encoded.reserve(points.size());
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        double qx = std::round((points[i].x - box.min_x) / scale);
+        double qy = std::round((points[i].y - box.min_y) / scale);
+        encoded.push_back({static_cast<std::int32_t>(qx),
+                           static_cast<std::int32_t>(qy),
+                           static_cast<int>(i)});
+
+        max_error = std::max(max_error, std::abs(box.min_x + qx * scale - points[i].x));
+        max_error = std::max(max_error, std::abs(box.min_y + qy * scale - points[i].y));
+    }
+
+    if (report) {
+        *report = {PointEncoding::Fixed32, box.min_x, box.min_y, scale,
+                   max_error, 2 * std::sqrt(2.0) * max_error};
+    }
+    return encoded;
+}
+
+PointEncoding choose_encoding(const std::vector<Point>& points, double tolerance) {
+    QuantizationReport report;
+
+    encode_fixed(points, 0.0, &report);
+    if (report.max_coord_error <= tolerance) return PointEncoding::Fixed32;
+
+    encode_float32(points, &report);
+    if (report.max_coord_error <= tolerance) return PointEncoding::Float32;
+
+    return PointEncoding::Float64;
+}
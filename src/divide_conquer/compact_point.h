@@ -0,0 +1,143 @@
+#ifndef COMPACT_POINT_H
+#define COMPACT_POINT_H
+
+#include "closest_pair.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 2D point with float32 coordinates (12 bytes instead of 24)
+ */
+struct PointF32 {
+    float x, y;
+    int id;
+};
+
+/**
+ * @brief 2D point with 32-bit fixed-point integer coordinates (12 bytes)
+ *
+ * Coordinates are quantized into [0, 2^30] so squared distances fit in
+ * int64 and comparisons between them are exact.
+ */
+struct PointFixed {
+    std::int32_t x, y;
+    int id;
+};
+
+/**
+ * @brief Scalar type, squared-distance type and coordinate access per point type
+ *
+ * Engines templated on the point type use these to pick the arithmetic:
+ * double for Point, float for PointF32 and exact int64 for PointFixed.
+ * get<K>(p) returns coordinate K (0 = x, 1 = y).
+ */
+template <typename P> struct PointTraits;
+
+/**
+ * @brief Traits shared by the 2D point types with x and y members
+ */
+template <typename P, typename S, typename D2>
+struct PointTraitsXY {
+    using Scalar = S;
+    using Dist2 = D2;
+    static constexpr int dims = 2;
+
+    template <int K>
+    static Scalar get(const P& p) {
+        static_assert(K == 0 || K == 1, "2D point has coordinates 0 and 1");
+        return K == 0 ? p.x : p.y;
+    }
+};
+
+template <> struct PointTraits<Point> : PointTraitsXY<Point, double, double> {};
+template <> struct PointTraits<PointF32> : PointTraitsXY<PointF32, float, float> {};
+template <> struct PointTraits<PointFixed>
+    : PointTraitsXY<PointFixed, std::int32_t, std::int64_t> {};
+
+namespace point_detail {
+
+template <typename P, int K>
+inline typename PointTraits<P>::Dist2 axis_delta(const P& a, const P& b) {
+    using Traits = PointTraits<P>;
+    using Dist2 = typename Traits::Dist2;
+    return static_cast<Dist2>(Traits::template get<K>(a)) -
+           static_cast<Dist2>(Traits::template get<K>(b));
+}
+
+template <typename P, int... K>
+inline typename PointTraits<P>::Dist2 squared_distance(const P& a, const P& b,
+                                                       std::integer_sequence<int, K...>) {
+    return ((axis_delta<P, K>(a, b) * axis_delta<P, K>(a, b)) + ...);
+}
+
+} // namespace point_detail
+
+/**
+ * @brief Squared distance in the representation's own arithmetic
+ *
+ * The sum over coordinates is a fold expression, so it is fully unrolled
+ * for every dimension.
+ */
+template <typename P>
+inline typename PointTraits<P>::Dist2 squared_distance(const P& a, const P& b) {
+    return point_detail::squared_distance(
+        a, b, std::make_integer_sequence<int, PointTraits<P>::dims>());
+}
+
+/**
+ * @brief Storage format for a point set
+ */
+enum class PointEncoding {
+    Float64,    // Point (no loss)
+    Float32,    // PointF32, relative to the bounding-box origin
+    Fixed32     // PointFixed, uniform grid over the bounding box
+};
+
+/**
+ * @brief Mapping between world coordinates and a compact encoding
+ *
+ * world = origin + encoded * scale (scale is 1 for Float32, which only
+ * re-centers). max_coord_error is measured over the actual data, and
+ * max_distance_error = 2·sqrt(2)·max_coord_error bounds how much any one
+ * pairwise distance can change. The closest distance found in the encoding
+ * can be off by twice that: both the pair it picks and the true closest
+ * pair move.
+ */
+struct QuantizationReport {
+    PointEncoding encoding;
+    double origin_x, origin_y;
+    double scale;
+    double max_coord_error;
+    double max_distance_error;
+};
+
+/**
+ * @brief Convert to float32 coordinates relative to the bounding-box minimum
+ *
+ * Point ids are replaced by the input index so results can be mapped back.
+ */
+std::vector<PointF32> encode_float32(const std::vector<Point>& points,
+                                     QuantizationReport* report = nullptr);
+
+/**
+ * @brief Quantize onto a uniform integer grid over the bounding box
+ *
+ * @param resolution World units per integer step; 0 picks the finest step
+ *        that keeps coordinates within [0, 2^30]
+ *
+ * Point ids are replaced by the input index so results can be mapped back.
+ */
+std::vector<PointFixed> encode_fixed(const std::vector<Point>& points,
+                                     double resolution = 0.0,
+                                     QuantizationReport* report = nullptr);
+
+/**
+ * @brief Pick the most compact encoding whose coordinate error <= tolerance
+ *
+ * Tries Fixed32 (at the finest resolution), then Float32, then falls back
+ * to Float64. With tolerance 0 only lossless encodings qualify.
+ */
+PointEncoding choose_encoding(const std::vector<Point>& points, double tolerance);
+
+#endif // COMPACT_POINT_H
@@ -0,0 +1,404 @@
+#include "external_closest_pair.h"
+#include "closest_pair_engine.h"
+#include "radix_sort.h"
+#include "../common/timer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <unistd.h>
+
+namespace {
+
+const std::size_t kRecordBytes = 20;
+const std::size_t kMinBufferBytes = 64u << 10;
+
+struct IoCounters {
+    long long bytes_read = 0;
+    long long bytes_written = 0;
+    double io_ms = 0.0;
+};
+
+bool less_x(const Point& a, const Point& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+bool less_y(const Point& a, const Point& b) {
+    return a.y < b.y || (a.y == b.y && a.x < b.x);
+}
+
+void encode_record(const Point& p, unsigned char* out) {
+    std::int32_t id = p.id;
+    std::memcpy(out, &p.x, 8);
+    std::memcpy(out + 8, &p.y, 8);
+    std::memcpy(out + 16, &id, 4);
+}
+
+Point decode_record(const unsigned char* in) {
+    Point p;
+    std::int32_t id;
+    std::memcpy(&p.x, in, 8);
+    std::memcpy(&p.y, in + 8, 8);
+    std::memcpy(&id, in + 16, 4);
+    p.id = id;
+    return p;
+}
+
+/**
+ * @brief Buffered sequential reader of point records
+ */
+class RecordReader {
+private:
+    std::FILE* file;
+    std::vector<unsigned char> buffer;
+    std::size_t pos, len;
+    IoCounters& io;
+
+    void refill() {
+        Timer timer;
+        timer.start();
+        len = std::fread(buffer.data(), 1, buffer.size(), file);
+        timer.stop();
+        io.io_ms += timer.elapsed_ms();
+        io.bytes_read += len;
+        len -= len % kRecordBytes;
+        pos = 0;
+    }
+
+public:
+    RecordReader(const std::string& path, std::size_t buffer_bytes, IoCounters& counters)
+        : file(std::fopen(path.c_str(), "rb")),
+          buffer(std::max(kRecordBytes, buffer_bytes - buffer_bytes % kRecordBytes)),
+          pos(0), len(0), io(counters) {}
+
+    ~RecordReader() {
+        if (file) std::fclose(file);
+    }
+
+    bool ok() const { return file != nullptr; }
+
+    bool next(Point& p) {
+        if (pos == len) {
+            refill();
+            if (len == 0) return false;
+        }
+        p = decode_record(buffer.data() + pos);
+        pos += kRecordBytes;
+        return true;
+    }
+};
+
+/**
+ * @brief Buffered sequential writer of point records
+ */
+class RecordWriter {
+private:
+    std::FILE* file;
+    std::vector<unsigned char> buffer;
+    std::size_t len;
+    IoCounters& io;
+    bool failed;
+
+public:
+    RecordWriter(const std::string& path, std::size_t buffer_bytes, IoCounters& counters)
+        : file(std::fopen(path.c_str(), "wb")),
+          buffer(std::max(kRecordBytes, buffer_bytes - buffer_bytes % kRecordBytes)),
+          len(0), io(counters), failed(file == nullptr) {}
+
+    ~RecordWriter() {
+        close();
+    }
+
+    bool ok() const { return !failed; }
+
+    void write(const Point& p) {
+        if (len == buffer.size()) flush();
+        encode_record(p, buffer.data() + len);
+        len += kRecordBytes;
+    }
+
+    void flush() {
+        if (!file || len == 0) return;
+        Timer timer;
+        timer.start();
+        if (std::fwrite(buffer.data(), 1, len, file) != len) failed = true;
+        timer.stop();
+        io.io_ms += timer.elapsed_ms();
+        io.bytes_written += len;
+        len = 0;
+    }
+
+    bool close() {
+        if (file) {
+            flush();
+            if (std::fclose(file) != 0) failed = true;
+            file = nullptr;
+        }
+        return !failed;
+    }
+};
+
+// Process-wide, so concurrent calls sharing a temp_dir never pick the same name
+std::atomic<unsigned long long> next_temp_file{0};
+
+std::string temp_path(const std::string& dir) {
+    return dir + "/lbsn_run_" + std::to_string(getpid()) + "_" +
+           std::to_string(next_temp_file.fetch_add(1)) + ".bin";
+}
+
+/**
+ * @brief Closest pair inside a y-sorted strip (any pair closer than best)
+ */
+void scan_strip(std::vector<Point>& strip, ClosestPairResult& best, long long& comparisons) {
+    std::sort(strip.begin(), strip.end(), less_y);
+    int m = strip.size();
+    for (int i = 0; i < m; ++i) {
+        for (int j = i + 1; j < m && strip[j].y - strip[i].y < best.distance; ++j) {
+            comparisons++;
+            double d = distance(strip[i], strip[j]);
+            if (d < best.distance) {
+                best.distance = d;
+                best.p1 = strip[i];
+                best.p2 = strip[j];
+            }
+        }
+    }
+}
+
+} // namespace
+
+bool write_points_file(const std::string& path, const std::vector<Point>& points) {
+    IoCounters io;
+    RecordWriter writer(path, 1u << 20, io);
+    if (!writer.ok()) return false;
+    for (const auto& p : points) writer.write(p);
+    return writer.close();
+}
+
+bool read_points_file(const std::string& path, std::vector<Point>& points) {
+    IoCounters io;
+    RecordReader reader(path, 1u << 20, io);
+    if (!reader.ok()) return false;
+    points.clear();
+    Point p;
+    while (reader.next(p)) points.push_back(p);
+    return true;
+}
+
+ExternalClosestPairResult external_closest_pair(const std::string& path,
+                                                const ExternalConfig& config) {
+    Timer total;
+    total.start();
+
+    ExternalClosestPairResult result;
+    result.pair.distance = std::numeric_limits<double>::infinity();
+    result.pair.runtime_ms = 0;
+    result.pair.comparisons = 0;
+    result.num_points = 0;
+    result.runs = result.merge_passes = result.slabs = 0;
+    result.peak_buffer_bytes = 0;
+    result.bytes_read = result.bytes_written = 0;
+    result.io_ms = result.throughput_mb_s = 0.0;
+
+    IoCounters io;
+    const std::size_t budget = std::max<std::size_t>(config.memory_budget_bytes, 1u << 20);
+    const std::size_t io_buffer = std::min<std::size_t>(
+        std::max<std::size_t>(budget / 16, kMinBufferBytes), 4u << 20);
+
+    // Temp files of the current pass (runs) and the merge pass in progress (merged)
+    std::vector<std::string> runs, merged;
+
+    auto fail = [&](const std::string& message) {
+        std::cerr << "Error: external closest pair: " << message << std::endl;
+        for (const auto& r : runs) std::remove(r.c_str());
+        for (const auto& m : merged) std::remove(m.c_str());
+        result.pair.runtime_ms = -1;
+        return result;
+    };
+
+    // ----- 1. Run formation: sorted runs of budget-sized chunks -----
+    {
+        RecordReader reader(path, io_buffer, io);
+        if (!reader.ok()) return fail("cannot open " + path);
+
+        // The radix sort needs a sorted copy and two (key, index) arrays
+        // next to the chunk, plus its digit histograms (8 passes overall,
+        // 8 + 2 per thread); its buffers are reused for every chunk
+        const std::size_t bytes_per_point = 2 * sizeof(Point) + 2 * sizeof(radix_detail::KeyIndex);
+        const int sort_threads = budget / bytes_per_point >= radix_detail::kParallelMin
+            ? ThreadPool::hardware_threads() : 1;
+        const std::size_t histogram_bytes =
+            (8 + 10 * (std::size_t)sort_threads) * 256 * sizeof(std::size_t);
+        const std::size_t chunk_points = std::max<std::size_t>(
+            2, (budget - 2 * io_buffer - histogram_bytes) / bytes_per_point);
+        std::vector<Point> chunk;
+        chunk.reserve(chunk_points);
+        RadixBuffers<Point> sort_buffers;
+
+        Point p;
+        bool more = true;
+        while (more) {
+            chunk.clear();
+            while (chunk.size() < chunk_points && (more = reader.next(p))) {
+                chunk.push_back(p);
+            }
+            if (chunk.empty()) break;
+
+            result.num_points += chunk.size();
+            radix_sort_by(chunk, [](const Point& q) { return q.x; }, less_x, sort_buffers,
+                          sort_threads);
+            result.peak_buffer_bytes = std::max(result.peak_buffer_bytes,
+                (chunk.capacity() + sort_buffers.sorted.capacity()) * sizeof(Point) +
+                (sort_buffers.keys.capacity() + sort_buffers.scratch.capacity()) *
+                    sizeof(radix_detail::KeyIndex) +
+                sort_buffers.counts.capacity() * sizeof(std::size_t) + 2 * io_buffer);
+
+            runs.push_back(temp_path(config.temp_dir));
+            RecordWriter writer(runs.back(), io_buffer, io);
+            if (!writer.ok()) return fail("cannot create " + runs.back());
+            for (const auto& q : chunk) writer.write(q);
+            if (!writer.close()) return fail("cannot write " + runs.back());
+        }
+    }
+    result.runs = runs.size();
+
+    // ----- 2. k-way merge passes until one sorted file remains -----
+    const int max_fan_in = std::max<int>(2, budget / kMinBufferBytes - 1);
+    while (runs.size() > 1) {
+        result.merge_passes++;
+        merged.clear();
+
+        for (size_t g = 0; g < runs.size(); g += max_fan_in) {
+            size_t group_end = std::min(runs.size(), g + max_fan_in);
+            size_t fan_in = group_end - g;
+            std::size_t buffer_bytes = budget / (fan_in + 1);
+
+            std::vector<std::unique_ptr<RecordReader>> readers;
+            for (size_t r = g; r < group_end; ++r) {
+                readers.emplace_back(new RecordReader(runs[r], buffer_bytes, io));
+                if (!readers.back()->ok()) return fail("cannot open " + runs[r]);
+            }
+
+            merged.push_back(temp_path(config.temp_dir));
+            RecordWriter writer(merged.back(), buffer_bytes, io);
+            if (!writer.ok()) return fail("cannot create " + merged.back());
+
+            using Head = std::pair<Point, int>;
+            auto after = [](const Head& a, const Head& b) { return less_x(b.first, a.first); };
+            std::priority_queue<Head, std::vector<Head>, decltype(after)> heads(after);
+
+            Point p;
+            for (size_t r = 0; r < fan_in; ++r) {
+                if (readers[r]->next(p)) heads.push({p, (int)r});
+            }
+            while (!heads.empty()) {
+                Head h = heads.top();
+                heads.pop();
+                writer.write(h.first);
+                if (readers[h.second]->next(p)) heads.push({p, h.second});
+            }
+            if (!writer.close()) return fail("cannot write " + merged.back());
+
+            readers.clear();
+            for (size_t r = g; r < group_end; ++r) std::remove(runs[r].c_str());
+        }
+        runs.swap(merged);
+    }
+    merged.clear();
+
+    if (result.num_points < 2) {
+        for (const auto& r : runs) std::remove(r.c_str());
+        total.stop();
+        result.pair.runtime_ms = total.elapsed_ms();
+        result.bytes_read = io.bytes_read;
+        result.bytes_written = io.bytes_written;
+        result.io_ms = io.io_ms;
+        return result;
+    }
+
+    // ----- 3 + 4. Slab pass with a boundary frontier -----
+    long long comparisons = 0;
+    ClosestPairResult& best = result.pair;
+
+    // Slab plus the engine's merge and strip buffers (grown to the largest slab)
+    const std::size_t slab_points = std::max<std::size_t>(
+        2, (budget - io_buffer) / (3 * sizeof(Point)));
+    std::vector<Point> slab, frontier, strip;
+    slab.reserve(slab_points);
+    ClosestPairEngine<Point> engine(0);
+    double frontier_max_x = -std::numeric_limits<double>::infinity();
+
+    {
+        RecordReader reader(runs[0], io_buffer, io);
+        if (!reader.ok()) return fail("cannot open " + runs[0]);
+
+        Point p;
+        bool more = true;
+        while (more) {
+            slab.clear();
+            while (slab.size() < slab_points && (more = reader.next(p))) {
+                slab.push_back(p);
+            }
+            if (slab.empty()) break;
+            result.slabs++;
+
+            double slab_max_x = slab.back().x;
+
+            // Cross-boundary pairs: frontier against the slab's left edge
+            if (!frontier.empty()) {
+                strip = frontier;
+                for (const auto& q : slab) {
+                    if (q.x - frontier_max_x >= best.distance) break;
+                    strip.push_back(q);
+                }
+                scan_strip(strip, best, comparisons);
+            }
+
+            // Pairs inside the slab: it is already in x order, so solve it
+            // without sorting (the engine leaves it in y order)
+            if (slab.size() >= 2) {
+                engine.reset(slab.size());
+                engine.solve(slab.data(), static_cast<int>(slab.size()));
+                comparisons += engine.comparisons;
+                double inside = std::sqrt(engine.best);
+                if (inside < best.distance) {
+                    best.distance = inside;
+                    best.p1 = engine.best_a;
+                    best.p2 = engine.best_b;
+                }
+            }
+
+            // New frontier: every seen point within delta of the new right edge
+            std::vector<Point> next_frontier;
+            for (const auto& q : frontier) {
+                if (slab_max_x - q.x < best.distance) next_frontier.push_back(q);
+            }
+            for (const auto& q : slab) {
+                if (slab_max_x - q.x < best.distance) next_frontier.push_back(q);
+            }
+            frontier.swap(next_frontier);
+            frontier_max_x = slab_max_x;
+
+            result.peak_buffer_bytes = std::max(result.peak_buffer_bytes,
+                (slab.capacity() + engine.scratch.capacity() + engine.strip.capacity() +
+                 frontier.capacity() + strip.capacity()) * sizeof(Point) + io_buffer);
+        }
+    }
+    std::remove(runs[0].c_str());
+
+    total.stop();
+    best.runtime_ms = total.elapsed_ms();
+    best.comparisons = comparisons;
+    result.bytes_read = io.bytes_read;
+    result.bytes_written = io.bytes_written;
+    result.io_ms = io.io_ms;
+    result.throughput_mb_s = best.runtime_ms > 0
+        ? (io.bytes_read + io.bytes_written) / 1e6 / (best.runtime_ms / 1000.0) : 0.0;
+    return result;
+}
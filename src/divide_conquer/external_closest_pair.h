@@ -0,0 +1,80 @@
+#ifndef EXTERNAL_CLOSEST_PAIR_H
+#define EXTERNAL_CLOSEST_PAIR_H
+
+#include "closest_pair.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Settings for the out-of-core closest pair
+ */
+struct ExternalConfig {
+    std::size_t memory_budget_bytes = 256u << 20;   // Bound on point buffers held in RAM
+    std::string temp_dir = "/tmp";                  // Where sorted runs are written
+};
+
+/**
+ * @brief Result of the out-of-core closest pair, with I/O accounting
+ */
+struct ExternalClosestPairResult {
+    ClosestPairResult pair;         // Closest pair (runtime_ms = end-to-end)
+    long long num_points;           // Points in the input file
+    int runs;                       // Sorted runs produced by run formation
+    int merge_passes;               // k-way merge passes over the data
+    int slabs;                      // In-memory slabs solved
+    long long bytes_read;           // Total bytes read (input + runs)
+    long long bytes_written;        // Total bytes written (runs)
+    double io_ms;                   // Time spent inside read/write calls
+    double throughput_mb_s;         // (bytes_read + bytes_written) / runtime
+    std::size_t peak_buffer_bytes;  // Largest point, sort and I/O buffer memory held at once
+};
+
+/**
+ * @brief Write points as packed 20-byte records (x, y: double; id: int32)
+ *
+ * Records use the native byte order; files are not meant to move between
+ * machines of different endianness.
+ *
+ * @return false if the file could not be written
+ */
+bool write_points_file(const std::string& path, const std::vector<Point>& points);
+
+/**
+ * @brief Read a file written by write_points_file
+ * @return false if the file could not be read
+ */
+bool read_points_file(const std::string& path, std::vector<Point>& points);
+
+/**
+ * @brief Closest pair of a point file larger than memory
+ *
+ * Algorithm:
+ * 1. Run formation: read chunks sized so the chunk and the radix sort's
+ *    buffers fit the budget, sort by x, write sorted runs
+ * 2. External merge: k-way merge runs (fan-in limited by the budget, so
+ *    more than one pass may be needed) into one x-sorted file
+ * 3. Slab pass: stream the sorted file in slabs that fit the budget and
+ *    solve each slab in memory (ClosestPairEngine::solve on the
+ *    already x-sorted slab: no copy, no re-sort)
+ * 4. Boundaries: keep a frontier of already-seen points with x within
+ *    delta of the largest x so far; each new slab only checks its points
+ *    with x < frontier max + delta against it (y-sorted strip scan).
+ *    The frontier spans several slabs when slabs are narrower than delta.
+ *
+ * Time Complexity: O(n log n) CPU, O(n/B · log_{M/B}(n/B)) I/Os
+ * Space Complexity: O(M) where M = memory_budget_bytes, plus the boundary
+ * frontier (points within delta of a slab edge, tiny for real data)
+ *
+ * On I/O failure a message is printed to std::cerr, every temp file of
+ * the call is removed and pair.runtime_ms is -1. Temp file names are
+ * unique per process, so concurrent calls may share a temp_dir.
+ *
+ * @param path Input file written by write_points_file
+ * @param config Memory budget and temp directory
+ * @return Closest pair plus I/O volume and throughput
+ */
+ExternalClosestPairResult external_closest_pair(const std::string& path,
+                                                const ExternalConfig& config = ExternalConfig());
+
+#endif // EXTERNAL_CLOSEST_PAIR_H
@@ -0,0 +1,82 @@
+#include "geo_closest_pair.h"
+#include "../common/timer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const double kDegToRad = 3.14159265358979323846 / 180.0;
+
+} // namespace
+
+PointND<3, double> geo_to_unit(const GeoPoint& p) {
+    double lat = p.lat * kDegToRad, lon = p.lon * kDegToRad;
+    double cos_lat = std::cos(lat);
+    return PointND<3, double>{{cos_lat * std::cos(lon), cos_lat * std::sin(lon), std::sin(lat)}, p.id};
+}
+
+double haversine_m(const GeoPoint& a, const GeoPoint& b) {
+    double dlat = (b.lat - a.lat) * kDegToRad;
+    double dlon = (b.lon - a.lon) * kDegToRad;
+    double s_lat = std::sin(dlat / 2), s_lon = std::sin(dlon / 2);
+    double h = s_lat * s_lat + std::cos(a.lat * kDegToRad) * std::cos(b.lat * kDegToRad) * s_lon * s_lon;
+    return 2 * kEarthRadiusM * std::asin(std::sqrt(std::min(1.0, h)));
+}
+
+GeoClosestPairResult geo_closest_pair(const std::vector<GeoPoint>& points) {
+    GeoClosestPairResult result{};
+    result.distance_m = std::numeric_limits<double>::infinity();
+    if (points.size() < 2) return result;
+
+    Timer timer, embed;
+    timer.start();
+    embed.start();
+
+    // Ids become input indices, to map the pair back
+    std::vector<PointND<3, double>> unit(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        unit[i] = geo_to_unit(points[i]);
+        unit[i].id = static_cast<int>(i);
+    }
+    embed.stop();
+
+    auto nd = closest_pair_nd(unit);
+
+    // Haversine of the winning pair from the input degrees: the unit-vector
+    // differences lose digits to cancellation for pairs meters apart
+    result.p1 = points[nd.p1.id];
+    result.p2 = points[nd.p2.id];
+    result.distance_m = haversine_m(result.p1, result.p2);
+    result.comparisons = nd.comparisons;
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    result.embed_ms = embed.elapsed_ms();
+    return result;
+}
+
+GeoClosestPairResult haversine_brute_force(const std::vector<GeoPoint>& points) {
+    GeoClosestPairResult result{};
+    result.distance_m = std::numeric_limits<double>::infinity();
+
+    Timer timer;
+    timer.start();
+
+    int n = points.size();
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            result.comparisons++;
+            double d = haversine_m(points[i], points[j]);
+            if (d < result.distance_m) {
+                result.distance_m = d;
+                result.p1 = points[i];
+                result.p2 = points[j];
+            }
+        }
+    }
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
@@ -0,0 +1,75 @@
+#ifndef GEO_CLOSEST_PAIR_H
+#define GEO_CLOSEST_PAIR_H
+
+#include "closest_pair_nd.h"
+#include <vector>
+
+/**
+ * @brief Mean Earth radius in meters (IUGG)
+ */
+constexpr double kEarthRadiusM = 6371008.8;
+
+/**
+ * @brief A location in degrees (WGS84-style latitude / longitude)
+ *
+ * Longitudes outside [-180, 180] are accepted: they are only used through
+ * sin / cos, so 190 and -170 are the same place.
+ */
+struct GeoPoint {
+    double lat, lon;
+    int id;     // User ID for tracking
+
+    GeoPoint(double latitude = 0, double longitude = 0, int user_id = 0)
+        : lat(latitude), lon(longitude), id(user_id) {}
+};
+
+/**
+ * @brief Result of a geographic closest pair
+ */
+struct GeoClosestPairResult {
+    GeoPoint p1, p2;        // The two closest locations
+    double distance_m;      // Great-circle distance between them in meters
+    double runtime_ms;      // Runtime in milliseconds (embedding included)
+    double embed_ms;        // Of which spent converting to unit vectors
+    long long comparisons;  // Number of distance comparisons made
+};
+
+/**
+ * @brief Unit vector of a location (x towards lon 0, z towards the north pole)
+ */
+PointND<3, double> geo_to_unit(const GeoPoint& p);
+
+/**
+ * @brief Great-circle distance in meters (haversine formula)
+ */
+double haversine_m(const GeoPoint& a, const GeoPoint& b);
+
+/**
+ * @brief Closest pair of locations by great-circle distance
+ *
+ * Each location is embedded once as a 3D unit vector and
+ * closest_pair_nd<3, double> runs on the Euclidean (chord) distance.
+ * Chord length 2·sin(θ/2) is monotone in the central angle θ, so the
+ * closest chord is the closest great-circle pair. The hot loop stays
+ * multiply-add only, and the only trigonometry is two sin/cos pairs per
+ * point up front plus one haversine for the reported distance.
+ *
+ * There is no seam: points on both sides of the antimeridian (lon 179.9
+ * and -179.9) are neighbours in 3D, and so are points around the poles.
+ *
+ * Time Complexity: O(n log n) (3D engine on points of a 2D surface)
+ *
+ * @param points Locations in degrees (not modified)
+ * @return Closest pair with its haversine distance in meters
+ */
+GeoClosestPairResult geo_closest_pair(const std::vector<GeoPoint>& points);
+
+/**
+ * @brief Brute force closest pair with haversine on every pair
+ *
+ * Reference for geo_closest_pair: O(n²) haversine evaluations, each with
+ * several trigonometric calls.
+ */
+GeoClosestPairResult haversine_brute_force(const std::vector<GeoPoint>& points);
+
+#endif // GEO_CLOSEST_PAIR_H
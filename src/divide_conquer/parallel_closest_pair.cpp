@@ -0,0 +1,115 @@
+#include "parallel_closest_pair.h"
+#include "closest_pair_engine.h"
+#include "../common/thread_pool.h"
+#include "../common/timer.h"
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace {
+
+// Below this many points per slab the boundary work outweighs the split
+const std::size_t kMinSlab = 1 << 12;
+
+} // namespace
+
+template <typename P>
+ClosestPairResult parallel_closest_pair(std::vector<P>& points, int num_threads) {
+    using Engine = ClosestPairEngine<P>;
+    using Traits = PointTraits<P>;
+    using Dist2 = typename Engine::Dist2;
+
+    ClosestPairResult result;
+    result.distance = std::numeric_limits<double>::infinity();
+    result.runtime_ms = 0;
+    result.comparisons = 0;
+    const std::size_t n = points.size();
+    if (n < 2) return result;
+
+    Timer timer;
+    timer.start();
+
+    if (num_threads <= 0) num_threads = ThreadPool::hardware_threads();
+    radix_sort_by(points,
+        [](const P& p) { return Traits::template get<0>(p); },
+        Engine::less_split, num_threads);
+
+    const int slabs = static_cast<int>(std::max<std::size_t>(1, std::min<std::size_t>(num_threads, n / kMinSlab)));
+    std::vector<std::size_t> bound(slabs + 1);
+    std::vector<Dist2> min_x(slabs), max_x(slabs);
+    for (int s = 0; s <= slabs; ++s) bound[s] = n * s / slabs;
+    for (int s = 0; s < slabs; ++s) {
+        min_x[s] = Engine::template coord<0>(points[bound[s]]);
+        max_x[s] = Engine::template coord<0>(points[bound[s + 1] - 1]);
+    }
+
+    // Slabs in parallel; each engine only allocates for its own slab
+    std::vector<std::unique_ptr<Engine>> engines(slabs);
+    parallel_for(0, slabs, num_threads, [&](long long s, int) {
+        std::size_t size = bound[s + 1] - bound[s];
+        engines[s] = std::make_unique<Engine>(size);
+        engines[s]->solve(points.data() + bound[s], static_cast<int>(size));
+        engines[s]->scratch = std::vector<P>();    // Release before the boundaries
+        engines[s]->strip = std::vector<P>();
+    });
+
+    Engine* best = engines[0].get();
+    long long comparisons = 0;
+    for (auto& e : engines) {
+        comparisons += e->comparisons;
+        if (e->best < best->best) best = e.get();
+    }
+    const Dist2 delta2 = best->best;
+
+    // Boundary b separates slab b - 1 from slab b; every slab is now in sweep order
+    std::vector<std::unique_ptr<Engine>> crossing(slabs);
+    parallel_for(1, slabs, num_threads, [&](long long b, int) {
+        const Dist2 mid_x = min_x[b];
+        auto near = [&](Dist2 x) { return (x - mid_x) * (x - mid_x) < delta2; };
+
+        int first = b, last = b - 1;       // Slabs with points within δ
+        while (first > 0 && near(max_x[first - 1])) {
+            --first;
+            if (!near(min_x[first])) break;
+        }
+        while (last + 1 < slabs && near(min_x[last + 1])) {
+            ++last;
+            if (!near(max_x[last])) break;
+        }
+
+        auto engine = std::make_unique<Engine>(0);
+        engine->best = delta2;
+        for (int s = first; s <= last; ++s) {
+            for (std::size_t i = bound[s]; i < bound[s + 1]; ++i) {
+                if (near(Engine::template coord<0>(points[i]))) engine->strip.push_back(points[i]);
+            }
+        }
+        std::sort(engine->strip.begin(), engine->strip.end(), Engine::less_sweep);
+
+        // Slabs narrower than δ pull in points from further away, which were
+        // never compared with each other: the packing cap no longer holds
+        if (first < b - 1 || last > b) {
+            engine->scan_unbounded(engine->strip.data(), static_cast<int>(engine->strip.size()));
+        } else {
+            engine->scan(engine->strip.data(), static_cast<int>(engine->strip.size()));
+        }
+        crossing[b] = std::move(engine);
+    });
+
+    for (int b = 1; b < slabs; ++b) {
+        comparisons += crossing[b]->comparisons;
+        if (crossing[b]->best < best->best) best = crossing[b].get();
+    }
+
+    timer.stop();
+    result.p1 = Point(best->best_a.x, best->best_a.y, best->best_a.id);
+    result.p2 = Point(best->best_b.x, best->best_b.y, best->best_b.id);
+    result.distance = std::sqrt(static_cast<double>(best->best));
+    result.runtime_ms = timer.elapsed_ms();
+    result.comparisons = comparisons;
+    return result;
+}
+
+template ClosestPairResult parallel_closest_pair<Point>(std::vector<Point>&, int);
+template ClosestPairResult parallel_closest_pair<PointF32>(std::vector<PointF32>&, int);
+template ClosestPairResult parallel_closest_pair<PointFixed>(std::vector<PointFixed>&, int);
@@ -0,0 +1,37 @@
+#ifndef PARALLEL_CLOSEST_PAIR_H
+#define PARALLEL_CLOSEST_PAIR_H
+
+#include "closest_pair.h"
+#include "compact_point.h"
+#include <vector>
+
+/**
+ * @brief Multi-threaded divide and conquer closest pair over a point type
+ *
+ * Algorithm:
+ * 1. Radix sort by coordinate 0 on num_threads threads
+ * 2. Cut the sorted points into num_threads slabs of equal size and solve
+ *    every slab with its own ClosestPairEngine, one slab per thread
+ * 3. δ = smallest slab result; a closer pair must cross a slab boundary,
+ *    so both of its points lie within δ of that boundary. Each boundary
+ *    collects those points from the slabs in reach, sorts them by the
+ *    sweep coordinate and scans them with the engine's strip scan. When a
+ *    slab is narrower than δ the strip spans more than the two adjacent
+ *    slabs; its points are not pairwise >= δ apart on each side, so that
+ *    strip is scanned without the packing cap (O(m²) worst case)
+ *
+ * The distance equals divide_conquer_closest_pair's on the same points
+ * (ties may pick a different pair); for PointF32 / PointFixed it is the
+ * distance in encoded units.
+ *
+ * Time Complexity: O(n log n / T) per thread plus O(n) for the boundary strips
+ * Space Complexity: O(n) scratch, split over the slab engines
+ *
+ * @param points Points in the engine's representation (reordered in place)
+ * @param num_threads Worker threads (0 = hardware threads)
+ * @return Closest pair; coordinates and distance are in encoded units
+ */
+template <typename P>
+ClosestPairResult parallel_closest_pair(std::vector<P>& points, int num_threads = 0);
+
+#endif // PARALLEL_CLOSEST_PAIR_H
@@ -0,0 +1,95 @@
+#include "radix_sort.h"
+
+namespace radix_detail {
+
+void radix_sort_keys(std::vector<KeyIndex>& items, std::vector<KeyIndex>& scratch,
+                     int num_threads) {
+    std::vector<std::size_t> counts;
+    radix_sort_keys(items, scratch, num_threads, counts);
+}
+
+void radix_sort_keys(std::vector<KeyIndex>& items, std::vector<KeyIndex>& scratch,
+                     int num_threads, std::vector<std::size_t>& counts) {
+    const std::size_t n = items.size();
+    const int kPasses = 8;
+    const int kBuckets = 256;
+
+    num_threads = std::max(1, num_threads);
+    const std::size_t block = (n + num_threads - 1) / num_threads;
+
+    // counts = global | partial[thread] | offset[thread] | local[thread]
+    const std::size_t histograms = (std::size_t)kPasses * kBuckets;
+    const std::size_t per_thread = (std::size_t)num_threads * kBuckets;
+    counts.resize(histograms * (1 + num_threads) + 2 * per_thread);
+    std::fill(counts.begin(), counts.begin() + histograms * (1 + num_threads), 0);
+    std::size_t* global = counts.data();
+    std::size_t* partial = global + histograms;
+    std::size_t* offset = partial + histograms * num_threads;
+    std::size_t* local = offset + per_thread;
+
+    // Digit counts of every pass in one read of the keys
+    {
+        parallel_for(0, num_threads, num_threads, [&](long long t, int) {
+            std::size_t* h = partial + (std::size_t)t * kPasses * kBuckets;
+            std::size_t lo = t * block, hi = std::min(n, lo + block);
+            for (std::size_t i = lo; i < hi; ++i) {
+                std::uint64_t key = items[i].key;
+                for (int pass = 0; pass < kPasses; ++pass) {
+                    h[pass * kBuckets + ((key >> (8 * pass)) & 0xFF)]++;
+                }
+            }
+        });
+        for (int t = 0; t < num_threads; ++t) {
+            for (std::size_t j = 0; j < histograms; ++j) {
+                global[j] += partial[(std::size_t)t * kPasses * kBuckets + j];
+            }
+        }
+    }
+
+    // offset[t][digit]: next output slot of thread t for that digit
+
+    for (int pass = 0; pass < kPasses; ++pass) {
+        const int shift = 8 * pass;
+        const std::size_t* count = global + pass * kBuckets;
+
+        // Skip the pass if every key has the same digit here
+        if (count[(items[0].key >> shift) & 0xFF] == n) continue;
+
+        if (num_threads == 1) {
+            std::size_t sum = 0;
+            for (int d = 0; d < kBuckets; ++d) {
+                offset[d] = sum;
+                sum += count[d];
+            }
+        } else {
+            // Blocks hold different keys after every scatter: recount per block
+            std::fill(local, local + per_thread, 0);
+            parallel_for(0, num_threads, num_threads, [&](long long t, int) {
+                std::size_t* h = local + (std::size_t)t * kBuckets;
+                std::size_t lo = t * block, hi = std::min(n, lo + block);
+                for (std::size_t i = lo; i < hi; ++i) h[(items[i].key >> shift) & 0xFF]++;
+            });
+
+            // Exclusive prefix over (digit, thread) keeps the sort stable
+            std::size_t sum = 0;
+            for (int d = 0; d < kBuckets; ++d) {
+                for (int t = 0; t < num_threads; ++t) {
+                    offset[(std::size_t)t * kBuckets + d] = sum;
+                    sum += local[(std::size_t)t * kBuckets + d];
+                }
+            }
+        }
+
+        parallel_for(0, num_threads, num_threads, [&](long long t, int) {
+            std::size_t* off = offset + (std::size_t)t * kBuckets;
+            std::size_t lo = t * block, hi = std::min(n, lo + block);
+            for (std::size_t i = lo; i < hi; ++i) {
+                scratch[off[(items[i].key >> shift) & 0xFF]++] = items[i];
+            }
+        });
+
+        items.swap(scratch);
+    }
+}
+
+} // namespace radix_detail
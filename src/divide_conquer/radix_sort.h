@@ -0,0 +1,181 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include "../common/thread_pool.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * @brief Order-preserving unsigned keys for coordinates
+ *
+ * For IEEE doubles, flipping the sign bit of positives and all bits of
+ * negatives makes unsigned integer order match numeric order. -0.0 is
+ * mapped to +0.0 so it ties with 0.0 exactly like operator<.
+ */
+inline std::uint64_t order_key(double v) {
+    if (v == 0.0) v = 0.0;
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+}
+
+inline std::uint64_t order_key(float v) {
+    if (v == 0.0f) v = 0.0f;
+    std::uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+inline std::uint64_t order_key(std::int32_t v) {
+    return static_cast<std::uint32_t>(v) ^ 0x80000000u;
+}
+
+/**
+ * @brief Sort axis for radix_sort_points
+ */
+enum class SortAxis {
+    X,  // (x, y) order, same as compare_x
+    Y   // (y, x) order, same as compare_y
+};
+
+namespace radix_detail {
+
+struct KeyIndex {
+    std::uint64_t key;
+    std::uint32_t index;
+};
+
+// Below this size std::sort wins; above kParallelMin the parallel variant is used
+const std::size_t kRadixMin = 256;
+const std::size_t kParallelMin = 1u << 20;
+
+/**
+ * @brief Stable LSD radix sort of (key, index) pairs, 8 bits per pass
+ *
+ * One histogram pass computes all 8 digit histograms; passes whose digit
+ * is the same for every key (e.g. shared exponent bytes) are skipped.
+ * With num_threads > 1 each thread histograms and scatters its own
+ * contiguous block; per-(digit, thread) offsets keep the sort stable.
+ */
+void radix_sort_keys(std::vector<KeyIndex>& items, std::vector<KeyIndex>& scratch,
+                     int num_threads);
+
+/**
+ * @brief Same, with the digit histograms kept in counts (resized as needed)
+ */
+void radix_sort_keys(std::vector<KeyIndex>& items, std::vector<KeyIndex>& scratch,
+                     int num_threads, std::vector<std::size_t>& counts);
+
+} // namespace radix_detail
+
+/**
+ * @brief Working memory of radix_sort_by, reusable across sorts
+ *
+ * Every vector only grows, so a caller sorting many inputs with one
+ * RadixBuffers (e.g. an engine reused across the instances of a batch)
+ * stops allocating once it has seen the largest input.
+ */
+template <typename T>
+struct RadixBuffers {
+    std::vector<radix_detail::KeyIndex> keys, scratch;
+    std::vector<T> sorted;
+    std::vector<std::size_t> counts;
+};
+
+/**
+ * @brief Sort items by an order_key-able primary field, ties by a comparator
+ *
+ * Algorithm:
+ * 1. Build (order_key(primary), index) pairs: 16 bytes instead of moving
+ *    whole items on every pass
+ * 2. Stable LSD radix sort on the 64-bit key (<= 8 passes)
+ * 3. Gather the items once in sorted order
+ * 4. Runs of equal primary keys are ordered with less, so the result is
+ *    exactly the order std::sort(less) would produce (less must order by
+ *    the primary field first)
+ *
+ * Time Complexity: O(n) passes over 16-byte pairs (plus O(r log r) per run
+ * of r equal primary keys, which is rare for real coordinates)
+ *
+ * @param items Items to sort in place
+ * @param primary Callable returning the primary field (double, float or int32)
+ * @param less Full strict weak order consistent with primary
+ * @param buffers Working memory (keys, scratch, sorted copy, histograms)
+ * @param num_threads Threads for large inputs (0 = automatic: hardware
+ *        threads once n >= 2^20, otherwise 1)
+ */
+template <typename T, typename Primary, typename Less>
+void radix_sort_by(std::vector<T>& items, Primary primary, Less less, RadixBuffers<T>& buffers,
+                   int num_threads = 0) {
+    using namespace radix_detail;
+    const std::size_t n = items.size();
+
+    if (n < kRadixMin) {
+        std::sort(items.begin(), items.end(), less);
+        return;
+    }
+    if (num_threads <= 0) {
+        num_threads = n >= kParallelMin ? ThreadPool::hardware_threads() : 1;
+    }
+
+    std::vector<KeyIndex>& keys = buffers.keys;
+    keys.resize(n);
+    buffers.scratch.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = {order_key(primary(items[i])), static_cast<std::uint32_t>(i)};
+    }
+
+    radix_sort_keys(keys, buffers.scratch, num_threads, buffers.counts);
+
+    // items and sorted trade storage below, so both keep the larger capacity
+    std::vector<T>& sorted = buffers.sorted;
+    sorted.resize(n);
+    parallel_for(0, n, num_threads, [&](long long i, int) {
+        sorted[i] = items[keys[i].index];
+    }, 1 << 14);
+
+    // Order ties on the primary key with the full comparator
+    for (std::size_t lo = 0; lo < n;) {
+        std::size_t hi = lo + 1;
+        while (hi < n && keys[hi].key == keys[lo].key) hi++;
+        if (hi - lo > 1) std::sort(sorted.begin() + lo, sorted.begin() + hi, less);
+        lo = hi;
+    }
+
+    items.swap(sorted);
+}
+
+/**
+ * @brief radix_sort_by with working memory allocated for this sort only
+ */
+template <typename T, typename Primary, typename Less>
+void radix_sort_by(std::vector<T>& items, Primary primary, Less less, int num_threads = 0) {
+    RadixBuffers<T> buffers;
+    radix_sort_by(items, primary, less, buffers, num_threads);
+}
+
+/**
+ * @brief Sort points by (x, y) or (y, x) with radix_sort_by
+ *
+ * The result matches compare_x / compare_y exactly.
+ *
+ * @param points Points to sort in place (any type with x, y members)
+ * @param axis SortAxis::X for (x, y) order, SortAxis::Y for (y, x) order
+ * @param num_threads Threads for large inputs (0 = automatic)
+ */
+template <typename P>
+void radix_sort_points(std::vector<P>& points, SortAxis axis, int num_threads = 0) {
+    if (axis == SortAxis::X) {
+        radix_sort_by(points, [](const P& p) { return p.x; },
+            [](const P& a, const P& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); },
+            num_threads);
+    } else {
+        radix_sort_by(points, [](const P& p) { return p.y; },
+            [](const P& a, const P& b) { return a.y < b.y || (a.y == b.y && a.x < b.x); },
+            num_threads);
+    }
+}
+
+#endif // RADIX_SORT_H
@@ -0,0 +1,103 @@
+#include "anytime_coverage.h"
+#include "../common/timer.h"
+#include "../common/perf_counters.h"
+#include "../common/alloc_tracker.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace {
+
+StopReason check(const AnytimeOptions& options) {
+    if (options.cancel.cancelled()) return StopReason::Cancelled;
+    if (AnytimeOptions::Clock::now() >= options.deadline) return StopReason::Deadline;
+    return StopReason::Completed;
+}
+
+} // namespace
+
+AnytimeCoverageResult greedy_max_coverage_anytime(const std::vector<User>& users, int k,
+                                                  const AnytimeOptions& options) {
+    AllocTracker memory;
+    PerfCounters counters;
+    Timer timer;
+    memory.start();
+    counters.start();
+    timer.start();
+
+    AnytimeCoverageResult out;
+    out.reason = StopReason::Completed;
+    out.iterations = 0;
+    out.upper_bound = -1;
+    CoverageResult& result = out.greedy;
+    result.selected_users.reserve(k);
+
+    std::unordered_set<int> covered;
+    std::vector<bool> selected(users.size(), false);
+    std::vector<int> top;           // Min-heap of the k largest gains of a scan
+    const int n = static_cast<int>(users.size());
+    const int check_every = std::max(1, options.check_every);
+
+    for (int iteration = 0; iteration < k && iteration < n; ++iteration) {
+        if ((out.reason = check(options)) != StopReason::Completed) break;
+
+        int best_user = -1;
+        int max_gain = 0;
+        top.clear();
+
+        for (int u = 0, until_check = check_every; u < n; ++u) {
+            if (--until_check == 0) {
+                until_check = check_every;
+                if ((out.reason = check(options)) != StopReason::Completed) break;
+            }
+            if (selected[u]) continue;
+
+            int gain = marginal_gain(users[u], covered);
+            if (gain > max_gain) {
+                max_gain = gain;
+                best_user = u;
+            }
+
+            if (static_cast<int>(top.size()) < k) {
+                top.push_back(gain);
+                std::push_heap(top.begin(), top.end(), std::greater<int>());
+            } else if (gain > top.front()) {
+                std::pop_heap(top.begin(), top.end(), std::greater<int>());
+                top.back() = gain;
+                std::push_heap(top.begin(), top.end(), std::greater<int>());
+            }
+        }
+        if (out.reason != StopReason::Completed) break;     // Partial scan: discarded
+
+        long long bound = static_cast<long long>(covered.size()) +
+                          std::accumulate(top.begin(), top.end(), 0LL);
+        if (out.upper_bound < 0 || bound < out.upper_bound) out.upper_bound = bound;
+
+        if (best_user == -1 || max_gain == 0) {
+            break;
+        }
+
+        selected[best_user] = true;
+        result.selected_users.push_back(best_user);
+        for (int loc : users[best_user].locations) {
+            covered.insert(loc);
+        }
+        out.iterations++;
+    }
+
+    out.stopped_early = out.reason != StopReason::Completed;
+    result.coverage = covered.size();
+    result.runtime_ms = timer.elapsed_ms();
+    counters.stop();
+    result.counters = counters.read();
+    memory.stop();
+    result.memory = memory.read();
+
+    return out;
+}
+
+std::future<AnytimeCoverageResult> greedy_max_coverage_async(ThreadPool& pool,
+                                                             const std::vector<User>& users, int k,
+                                                             AnytimeOptions options) {
+    return pool.submit([&users, k, options] { return greedy_max_coverage_anytime(users, k, options); });
+}
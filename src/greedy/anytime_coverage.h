@@ -0,0 +1,125 @@
+#ifndef ANYTIME_COVERAGE_H
+#define ANYTIME_COVERAGE_H
+
+#include "max_coverage.h"
+#include "../common/thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Cooperative cancellation flag
+ *
+ * Copies share one flag, so a caller keeps a copy and cancels a query that
+ * is queued or running elsewhere. Cancelling is a relaxed store; the query
+ * notices at its next check.
+ */
+class CancellationToken {
+public:
+    CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { flag->store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return flag->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+/**
+ * @brief Stop conditions of an anytime query
+ */
+struct AnytimeOptions {
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point deadline = Clock::time_point::max();
+    CancellationToken cancel;
+    int check_every = 256;          // Candidates scanned between checks
+
+    /**
+     * @brief Options with a deadline ms milliseconds from now
+     */
+    static AnytimeOptions within(double ms) {
+        AnytimeOptions options;
+        options.deadline = Clock::now() +
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+        return options;
+    }
+};
+
+/**
+ * @brief Why an anytime query returned
+ */
+enum class StopReason {
+    Completed,      // k picks made, or no user adds coverage
+    Deadline,       // Deadline passed
+    Cancelled       // Token cancelled
+};
+
+/**
+ * @brief Result of an anytime greedy query
+ *
+ * greedy.selected_users is always a prefix of what greedy_max_coverage
+ * picks on the same input: iterations that were interrupted are dropped.
+ *
+ * upper_bound bounds the optimal coverage with k users: after a complete
+ * gain scan at selection S, OPT <= f(S) + (sum of the k largest marginal
+ * gains), by submodularity. The smallest such bound over the completed
+ * scans is kept (-1 if not even the first scan completed).
+ */
+struct AnytimeCoverageResult {
+    CoverageResult greedy;      // Selection so far, its coverage and runtime
+    bool stopped_early;         // reason != Completed
+    StopReason reason;
+    int iterations;             // Completed picks
+    long long upper_bound;      // Bound on the optimal coverage (-1 = none yet)
+
+    /**
+     * @brief Guaranteed fraction of the optimum: coverage / upper_bound (0 if no bound)
+     */
+    double guarantee() const {
+        return upper_bound > 0 ? static_cast<double>(greedy.coverage) / upper_bound
+                               : (upper_bound == 0 ? 1.0 : 0.0);
+    }
+};
+
+/**
+ * @brief greedy_max_coverage that stops at a deadline or on cancellation
+ *
+ * The stop conditions are checked before every iteration and every
+ * options.check_every candidates inside the gain scan (one clock read and
+ * one relaxed load), so a query overruns its deadline by at most about
+ * check_every marginal-gain evaluations.
+ *
+ * Picks and tie-breaking are those of greedy_max_coverage; with no
+ * deadline and no cancellation the selection is identical.
+ *
+ * Time Complexity: O(k * n * (m + log k)) for the gains and the top-k bound
+ *
+ * @param users Vector of users with their location sets
+ * @param k Maximum number of users to select
+ * @param options Deadline, cancellation token and check interval
+ * @return Selection so far with its stop reason and optimality bound
+ */
+AnytimeCoverageResult greedy_max_coverage_anytime(const std::vector<User>& users, int k,
+                                                  const AnytimeOptions& options = AnytimeOptions());
+
+/**
+ * @brief Run greedy_max_coverage_anytime as a task on a shared pool
+ *
+ * The deadline is absolute, so time spent queued behind other queries
+ * counts against it; a query that starts after its deadline returns at
+ * once with an empty selection. users must outlive the future.
+ *
+ * @param pool Pool shared by all in-flight queries
+ * @param users Vector of users with their location sets
+ * @param k Maximum number of users to select
+ * @param options Deadline, cancellation token and check interval
+ * @return Future of the query's result
+ */
+std::future<AnytimeCoverageResult> greedy_max_coverage_async(ThreadPool& pool,
+                                                             const std::vector<User>& users, int k,
+                                                             AnytimeOptions options = AnytimeOptions());
+
+#endif // ANYTIME_COVERAGE_H
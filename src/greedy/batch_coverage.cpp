@@ -0,0 +1,126 @@
+#include "batch_coverage.h"
+#include "../common/thread_pool.h"
+#include "../common/timer.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+/**
+ * @brief Per-worker marks; an entry equals epoch iff it is set for the
+ *        current instance (cache-line aligned, epoch changes per instance)
+ */
+struct alignas(64) GreedyScratch {
+    std::vector<std::uint32_t> covered;
+    std::vector<std::uint32_t> selected;
+    std::uint32_t epoch = 0;
+
+    void next_instance(int locations, int users) {
+        if (static_cast<int>(covered.size()) < locations) covered.resize(locations, 0);
+        if (static_cast<int>(selected.size()) < users) selected.resize(users, 0);
+        if (++epoch == 0) {     // Wrapped: old stamps could alias
+            std::fill(covered.begin(), covered.end(), 0);
+            std::fill(selected.begin(), selected.end(), 0);
+            epoch = 1;
+        }
+    }
+};
+
+/**
+ * @brief Greedy on instance i, writing picks to out; returns the coverage
+ */
+int solve_instance(const CoverageBatch& batch, int i, GreedyScratch& scratch, int* out, int& picked) {
+    const int first_user = batch.user_start[i];
+    const int n = batch.num_users(i);
+    const int* loc_start = batch.loc_start.data() + first_user;
+    const int* locations = batch.locations.data();
+
+    scratch.next_instance(batch.num_locations[i], n);
+    const std::uint32_t epoch = scratch.epoch;
+    std::uint32_t* covered = scratch.covered.data();
+    std::uint32_t* selected = scratch.selected.data();
+
+    int coverage = 0;
+    picked = 0;
+    for (int iteration = 0; iteration < batch.k[i] && iteration < n; ++iteration) {
+        int best_user = -1;
+        int max_gain = 0;
+
+        for (int u = 0; u < n; ++u) {
+            if (selected[u] == epoch) continue;
+            int gain = 0;
+            for (int j = loc_start[u]; j < loc_start[u + 1]; ++j) {
+                gain += covered[locations[j]] != epoch;
+            }
+            if (gain > max_gain) {
+                max_gain = gain;
+                best_user = u;
+            }
+        }
+
+        if (best_user == -1) break;
+
+        selected[best_user] = epoch;
+        out[picked++] = best_user;
+        for (int j = loc_start[best_user]; j < loc_start[best_user + 1]; ++j) {
+            covered[locations[j]] = epoch;
+        }
+        coverage += max_gain;
+    }
+    return coverage;
+}
+
+} // namespace
+
+int CoverageBatch::add(const std::vector<User>& users, int select_k) {
+    remap.clear();
+    for (const auto& user : users) {
+        for (int loc : user.locations) {
+            auto it = remap.try_emplace(loc, static_cast<int>(remap.size())).first;
+            locations.push_back(it->second);
+        }
+        loc_start.push_back(static_cast<int>(locations.size()));
+    }
+    user_start.push_back(static_cast<int>(loc_start.size()) - 1);
+    num_locations.push_back(static_cast<int>(remap.size()));
+    k.push_back(select_k);
+    return size() - 1;
+}
+
+BatchCoverageResult greedy_max_coverage_batch(const CoverageBatch& batch, ThreadPool& pool) {
+    Timer timer;
+    timer.start();
+
+    const int instances = batch.size();
+    const int num_threads = pool.size();
+
+    BatchCoverageResult result;
+    result.threads = num_threads;
+    result.coverage.assign(instances, 0);
+
+    // Each instance picks at most min(k, n) users: give it that many slots
+    std::vector<int> slot_start(instances + 1, 0);
+    for (int i = 0; i < instances; ++i) {
+        slot_start[i + 1] = slot_start[i] + std::max(0, std::min(batch.k[i], batch.num_users(i)));
+    }
+    std::vector<int> slots(slot_start[instances]);
+    std::vector<int> picked(instances, 0);
+    std::vector<GreedyScratch> scratch(num_threads);
+
+    parallel_for(pool, 0, instances, [&](long long i, int worker) {
+        result.coverage[i] = solve_instance(batch, i, scratch[worker], slots.data() + slot_start[i], picked[i]);
+    }, 64);
+
+    // Compact the slots into the CSR result
+    result.selected_start.assign(instances + 1, 0);
+    for (int i = 0; i < instances; ++i) result.selected_start[i + 1] = result.selected_start[i] + picked[i];
+    result.selected.resize(result.selected_start[instances]);
+    for (int i = 0; i < instances; ++i) {
+        std::copy(slots.begin() + slot_start[i], slots.begin() + slot_start[i] + picked[i],
+                  result.selected.begin() + result.selected_start[i]);
+    }
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
@@ -0,0 +1,83 @@
+#ifndef BATCH_COVERAGE_H
+#define BATCH_COVERAGE_H
+
+#include "max_coverage.h"
+#include "../common/thread_pool.h"
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Many small coverage instances packed into one arena (CSR layout)
+ *
+ * Instance i owns users [user_start[i], user_start[i+1]); user u visits
+ * locations[loc_start[u] .. loc_start[u+1]). Location ids are remapped to
+ * 0 .. num_locations[i] - 1 per instance when the instance is added, so the
+ * solver can mark covered locations in a flat array instead of a hash set.
+ *
+ * Packing happens once; the three flat vectors replace the per-user
+ * unordered_sets and per-call vectors of greedy_max_coverage.
+ */
+struct CoverageBatch {
+    std::vector<int> user_start;        // Size instances + 1, into loc_start
+    std::vector<int> loc_start;         // Size total users + 1, into locations
+    std::vector<int> locations;         // Dense location ids, per instance
+    std::vector<int> num_locations;     // Distinct locations per instance
+    std::vector<int> k;                 // Users to select per instance
+
+    CoverageBatch() : user_start(1, 0), loc_start(1, 0) {}
+
+    /**
+     * @brief Append an instance
+     * @return Index of the instance in the batch
+     */
+    int add(const std::vector<User>& users, int select_k);
+
+    int size() const { return static_cast<int>(k.size()); }
+    int num_users(int i) const { return user_start[i + 1] - user_start[i]; }
+
+private:
+    std::unordered_map<int, int> remap;     // Reused across add() calls
+};
+
+/**
+ * @brief Greedy picks for every instance of a batch
+ *
+ * The selection of instance i is selected[selected_start[i] ..
+ * selected_start[i+1]), in pick order, as user indices local to the
+ * instance (positions in the vector passed to CoverageBatch::add).
+ */
+struct BatchCoverageResult {
+    std::vector<int> selected_start;    // Size instances + 1
+    std::vector<int> selected;
+    std::vector<int> coverage;          // Locations covered per instance
+    double runtime_ms;                  // Whole batch
+    int threads;                        // Pool workers used
+
+    double instances_per_second() const {
+        return runtime_ms > 0 ? coverage.size() * 1000.0 / runtime_ms : 0.0;
+    }
+};
+
+/**
+ * @brief greedy_max_coverage over every instance of a batch
+ *
+ * Same picks as calling greedy_max_coverage on each instance (same
+ * marginal gains and tie-breaking: lowest user index among the maximum
+ * gains, stop at zero gain).
+ *
+ * Instances are spread in chunks over the workers of an existing pool (no
+ * thread is started per call); each worker owns scratch arrays sized for
+ * the largest instance it has seen. Covered
+ * locations and selected users are marked with an epoch stamp, so moving
+ * to the next instance costs one increment rather than clearing or
+ * reallocating anything.
+ *
+ * Time Complexity: O(k * L) per instance for L location visits in total
+ * Space Complexity: O(max locations + max users) scratch per worker
+ *
+ * @param batch Packed instances
+ * @param pool Pool whose workers solve the instances (not one this call runs on)
+ */
+BatchCoverageResult greedy_max_coverage_batch(const CoverageBatch& batch, ThreadPool& pool);
+
+#endif // BATCH_COVERAGE_H
@@ -0,0 +1,68 @@
+#include "coverage_cache.h"
+#include "../common/fingerprint.h"
+#include "../common/timer.h"
+#include <algorithm>
+
+uint64_t fingerprint(const std::vector<User>& users) {
+    Fingerprinter fp;
+    fp.add(static_cast<uint64_t>(users.size()));
+    for (const User& user : users) {
+        uint64_t set_hash = 0;
+        for (int loc : user.locations) {
+            set_hash += Fingerprinter::mix(static_cast<uint64_t>(static_cast<uint32_t>(loc)));
+        }
+        fp.add(static_cast<uint64_t>(user.locations.size()));
+        fp.add(set_hash);
+    }
+    return fp.digest();
+}
+
+CoverageResult CoverageCache::solve(const std::vector<User>& users, int k) {
+    Timer timer;
+    timer.start();
+    CoverageResult result = solve(fingerprint(users), users, k);
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
+
+CoverageResult CoverageCache::solve(uint64_t key, const std::vector<User>& users, int k) {
+    Timer timer;
+    timer.start();
+
+    std::shared_ptr<const GreedyTrace> trace = cache.get(key, [k](const GreedyTrace& t) {
+        return k <= t.k_max || t.exhausted;
+    });
+
+    if (trace) {
+        CoverageResult result;
+        int picks = std::min<int>(std::max(k, 0), trace->selected_users.size());
+        result.selected_users.assign(trace->selected_users.begin(), trace->selected_users.begin() + picks);
+        result.coverage = picks > 0 ? trace->coverage_after[picks - 1] : 0;
+        result.runtime_ms = timer.elapsed_ms();
+        return result;
+    }
+
+    const int k_max = std::max(k, trace_k);
+    CoverageResult result = greedy_max_coverage(users, k_max);
+
+    // Replay the picks for the per-prefix coverage
+    auto fresh = std::make_shared<GreedyTrace>();
+    fresh->selected_users = result.selected_users;
+    fresh->coverage_after.reserve(result.selected_users.size());
+    std::unordered_set<int> covered;
+    for (int u : result.selected_users) {
+        covered.insert(users[u].locations.begin(), users[u].locations.end());
+        fresh->coverage_after.push_back(covered.size());
+    }
+    fresh->k_max = k_max;
+    fresh->exhausted = static_cast<int>(result.selected_users.size()) < k_max;
+
+    if (static_cast<int>(result.selected_users.size()) > k) {
+        result.selected_users.resize(std::max(k, 0));
+        result.coverage = k > 0 ? fresh->coverage_after[k - 1] : 0;
+    }
+    cache.put(key, std::move(fresh));
+
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
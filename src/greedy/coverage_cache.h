@@ -0,0 +1,75 @@
+#ifndef COVERAGE_CACHE_H
+#define COVERAGE_CACHE_H
+
+#include "max_coverage.h"
+#include "../common/lru_cache.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Content fingerprint of a coverage instance
+ *
+ * Users in order (indices are what greedy returns); each user contributes
+ * its location count and an order-free sum of mixed location ids, so two
+ * equal unordered_sets hash the same whatever their bucket order. User ids
+ * are not hashed: they do not affect the result.
+ *
+ * Time Complexity: O(total locations)
+ */
+uint64_t fingerprint(const std::vector<User>& users);
+
+/**
+ * @brief Greedy selection order of one instance, with coverage after each pick
+ */
+struct GreedyTrace {
+    std::vector<int> selected_users;
+    std::vector<int> coverage_after;    // coverage_after[i] = coverage of the first i + 1 picks
+    int k_max;                          // k the trace was computed for
+    bool exhausted;                     // Stopped before k_max: no user adds coverage
+};
+
+/**
+ * @brief LRU cache of greedy_max_coverage results keyed by instance fingerprint
+ *
+ * Greedy picks do not depend on k (the loop just stops after k), so the
+ * first k picks of a run for k_max are the run for k. One trace per
+ * instance therefore answers every k <= k_max, and every k at all once the
+ * gains ran out. A larger k is a miss that recomputes and replaces the
+ * trace; a miss computes at least trace_k picks so that later, larger
+ * queries up to trace_k hit.
+ *
+ * A hit costs the fingerprint plus a prefix copy. Callers that query an
+ * unchanged snapshot many times should compute fingerprint(users) once and
+ * use the overload taking it, which makes a hit O(k).
+ */
+class CoverageCache {
+private:
+    LruCache<GreedyTrace> cache;
+    int trace_k;
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of instances kept
+     * @param trace_k Minimum number of picks computed on a miss (0 = just k)
+     */
+    explicit CoverageCache(size_t capacity, int trace_k = 0) : cache(capacity), trace_k(trace_k) {}
+
+    /**
+     * @brief greedy_max_coverage(users, k), served from the cache when possible
+     *
+     * On a hit runtime_ms is the time of the lookup, and counters / memory
+     * are left unavailable (-1). On a miss it also covers recording the trace.
+     */
+    CoverageResult solve(const std::vector<User>& users, int k);
+
+    /**
+     * @brief Same, with the instance's fingerprint computed by the caller
+     */
+    CoverageResult solve(uint64_t key, const std::vector<User>& users, int k);
+
+    CacheStats stats() const { return cache.stats(); }
+    void clear() { cache.clear(); }
+};
+
+#endif // COVERAGE_CACHE_H
@@ -1,7 +1,12 @@
 #include "max_coverage.h"
 #include "../common/timer.h"
+#include "../common/perf_counters.h"
+#include "../common/alloc_tracker.h"
+#include "../common/trace.h"
+#include "../common/thread_pool.h"
 #include <algorithm>
 #include <random>
+#include <functional>
 #include <iostream>
 
 // Helper function to compute coverage
@@ -18,9 +23,14 @@ int compute_coverage(const std::vector<User>& users,
 
 // Greedy maximum coverage algorithm
 CoverageResult greedy_max_coverage(const std::vector<User>& users, int k) {
+    AllocTracker memory;
+    PerfCounters counters;
     Timer timer;
+    memory.start();
+    counters.start();
     timer.start();
 
+    TRACE_BEGIN(call_trace, TracePhase::Greedy);
     CoverageResult result;
     result.selected_users.reserve(k);
 
@@ -31,18 +41,17 @@ CoverageResult greedy_max_coverage(const std::vector<User>& users, int k) {
     for (int iteration = 0; iteration < k && iteration < users.size(); ++iteration) {
         int best_user = -1;
         int max_gain = 0;
+        TRACE_STMT(Timer iteration_timer; iteration_timer.start();)
+        TRACE_STMT(long long candidates = 0; long long gain_evaluations = 0;)
+        TRACE_BEGIN(scan_trace, TracePhase::GreedyScan);
 
         // Find user with maximum marginal gain
         for (size_t u = 0; u < users.size(); ++u) {
             if (selected[u]) continue;  // Skip already selected users
 
             // Compute marginal gain: count new locations
-            int gain = 0;
-            for (int loc : users[u].locations) {
-                if (covered.find(loc) == covered.end()) {
-                    gain++;
-                }
-            }
+            int gain = marginal_gain(users[u], covered);
+            TRACE_STMT(candidates++; gain_evaluations += users[u].locations.size();)
 
             // Update best user if this gain is better
             if (gain > max_gain) {
@@ -51,6 +60,8 @@ CoverageResult greedy_max_coverage(const std::vector<User>& users, int k) {
             }
         }
 
+        TRACE_END(scan_trace);
+
         // If no user provides positive gain, stop early
         if (best_user == -1 || max_gain == 0) {
             break;
@@ -61,20 +72,100 @@ CoverageResult greedy_max_coverage(const std::vector<User>& users, int k) {
         result.selected_users.push_back(best_user);
 
         // Update covered locations
+        TRACE_BEGIN(update_trace, TracePhase::GreedyUpdate);
         for (int loc : users[best_user].locations) {
             covered.insert(loc);
         }
+        TRACE_END(update_trace);
+
+        TRACE_LOG(log, log->greedy_iterations.push_back({iteration, candidates, gain_evaluations,
+                                                         max_gain, best_user,
+                                                         iteration_timer.elapsed_ms()}));
+    }
+
+    result.coverage = covered.size();
+    TRACE_END(call_trace);
+    result.runtime_ms = timer.elapsed_ms();
+    counters.stop();
+    result.counters = counters.read();
+    memory.stop();
+    result.memory = memory.read();
+
+    return result;
+}
+
+// Greedy with the per-iteration gain scan on several threads
+CoverageResult greedy_max_coverage_parallel(const std::vector<User>& users, int k, int num_threads) {
+    AllocTracker memory;
+    PerfCounters counters;
+    Timer timer;
+    memory.start();
+    counters.start();
+    timer.start();
+
+    if (num_threads <= 0) num_threads = ThreadPool::hardware_threads();
+
+    CoverageResult result;
+    result.selected_users.reserve(k);
+
+    std::unordered_set<int> covered;
+    std::vector<char> selected(users.size(), 0);    // char: no shared bit words
+
+    // Per-worker candidate, padded to a cache line
+    struct alignas(64) Candidate {
+        int gain;
+        long long user;
+    };
+    std::vector<Candidate> best(num_threads);
+    const long long n = static_cast<long long>(users.size());
+
+    for (int iteration = 0; iteration < k && iteration < n; ++iteration) {
+        for (auto& c : best) c = {0, -1};
+
+        // Chunks are claimed in increasing order, so a worker only replaces
+        // its candidate on a strictly larger gain
+        parallel_for(0, n, num_threads, [&](long long u, int worker) {
+            if (selected[u]) return;
+            int gain = marginal_gain(users[u], covered);
+            Candidate& c = best[worker];
+            if (gain > c.gain) c = {gain, u};
+        }, 1024);
+
+        Candidate winner{0, -1};
+        for (const auto& c : best) {
+            if (c.gain > winner.gain || (c.gain == winner.gain && c.user >= 0 && c.user < winner.user)) {
+                winner = c;
+            }
+        }
+
+        if (winner.user == -1 || winner.gain == 0) {
+            break;
+        }
+
+        selected[winner.user] = 1;
+        result.selected_users.push_back(static_cast<int>(winner.user));
+        for (int loc : users[winner.user].locations) {
+            covered.insert(loc);
+        }
     }
 
     result.coverage = covered.size();
     result.runtime_ms = timer.elapsed_ms();
+    counters.stop();
+    result.counters = counters.read();
+    memory.stop();
+    result.memory = memory.read();
 
     return result;
 }
 
 // Brute force algorithm (optimal solution for small inputs)
 CoverageResult brute_force_max_coverage(const std::vector<User>& users, int k) {
+    AllocTracker memory;
+    PerfCounters counters;
     Timer timer;
+    memory.start();
+    counters.start();
     timer.start();
 
     CoverageResult result;
@@ -109,13 +200,21 @@ CoverageResult brute_force_max_coverage(const std::vector<User>& users, int k) {
 
     generate_combinations(0, 0);
     result.runtime_ms = timer.elapsed_ms();
+    counters.stop();
+    result.counters = counters.read();
+    memory.stop();
+    result.memory = memory.read();
 
     return result;
 }
 
 // Random selection baseline
 CoverageResult random_max_coverage(const std::vector<User>& users, int k, int seed) {
+    AllocTracker memory;
+    PerfCounters counters;
     Timer timer;
+    memory.start();
+    counters.start();
     timer.start();
 
     CoverageResult result;
@@ -138,6 +237,10 @@ CoverageResult random_max_coverage(const std::vector<User>& users, int k, int se
     // Compute coverage
     result.coverage = compute_coverage(users, result.selected_users);
     result.runtime_ms = timer.elapsed_ms();
+    counters.stop();
+    result.counters = counters.read();
+    memory.stop();
+    result.memory = memory.read();
 
     return result;
 }
@@ -1,6 +1,8 @@
 #ifndef MAX_COVERAGE_H
 #define MAX_COVERAGE_H
 
+#include "../common/alloc_tracker.h"
+#include "../common/perf_counters.h"
 #include <vector>
 #include <unordered_set>
 #include <set>
@@ -12,6 +14,8 @@ struct CoverageResult {
     std::vector<int> selected_users;  // Indices of selected users
     int coverage;                      // Total unique locations covered
     double runtime_ms;                 // Runtime in milliseconds
+    PerfCounts counters;               // Hardware counters (-1 if unavailable)
+    AllocStats memory;                 // Heap/RSS usage (-1 unless built with TRACK_ALLOC)
 };
 
 /**
@@ -48,6 +52,24 @@ public:
  */
 CoverageResult greedy_max_coverage(const std::vector<User>& users, int k);
 
+/**
+ * @brief Greedy maximum coverage with the gain scan split over threads
+ *
+ * Each iteration evaluates the marginal gains of all unselected users on
+ * num_threads threads (read-only lookups in the shared covered set); each
+ * thread keeps its best candidate and the lowest index wins ties, so the
+ * picks are exactly those of greedy_max_coverage. The covered-set update
+ * stays sequential.
+ *
+ * Time Complexity: O(k * n * m / T) plus O(k * m) sequential per call
+ *
+ * @param users Vector of users with their location sets
+ * @param k Maximum number of users to select
+ * @param num_threads Worker threads (0 = hardware threads)
+ * @return CoverageResult containing selected users and coverage
+ */
+CoverageResult greedy_max_coverage_parallel(const std::vector<User>& users, int k, int num_threads = 0);
+
 /**
  * @brief Brute force algorithm for maximum coverage (optimal solution)
  *
@@ -75,6 +97,21 @@ CoverageResult brute_force_max_coverage(const std::vector<User>& users, int k);
  */
 CoverageResult random_max_coverage(const std::vector<User>& users, int k, int seed = 42);
 
+/**
+ * @brief Marginal gain of a user: locations not yet in the covered set
+ *
+ * Inner kernel of greedy_max_coverage (one hash lookup per location).
+ */
+inline int marginal_gain(const User& user, const std::unordered_set<int>& covered) {
+    int gain = 0;
+    for (int loc : user.locations) {
+        if (covered.find(loc) == covered.end()) {
+            gain++;
+        }
+    }
+    return gain;
+}
+
 /**
  * @brief Compute coverage of a given set of users
  *
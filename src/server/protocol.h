@@ -0,0 +1,122 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief Binary protocol of the query server (local Unix socket)
+ *
+ * A client writes fixed 16-byte RequestFrames, any number per write; the
+ * server answers each with a 16-byte ResponseHeader followed by
+ * payload_bytes of payload, in the order the requests were sent. Fields
+ * are in host byte order: both ends run on the same machine.
+ *
+ * Payloads:
+ * - Greedy / Exact: int32 coverage, int32 count, int32 users[count]
+ * - ClosestPair: double distance, int32 id1, int32 id2
+ * - Info: uint32 coverage instances C, uint32 point sets P,
+ *         uint32 users[C], uint32 points[P]
+ * - Stats: per op in Greedy, Exact, ClosestPair order:
+ *          uint64 count, p50_ns, p99_ns, max_ns (server-side latency)
+ * Errors carry no payload.
+ */
+namespace protocol {
+
+enum class Op : uint8_t {
+    Greedy = 1,         // greedy_max_coverage(instance, k)
+    Exact = 2,          // brute_force_max_coverage(instance, k), small instances only
+    ClosestPair = 3,    // divide_conquer_closest_pair(point set)
+    Info = 4,           // Loaded instances and their sizes
+    Stats = 5           // Server-side latency summaries
+};
+
+constexpr int kQueryOps = 3;        // Ops with a latency histogram: Greedy, Exact, ClosestPair
+
+enum class Status : uint8_t {
+    Ok = 0,
+    UnknownInstance = 1,
+    BadRequest = 2,
+    TooLarge = 3,       // Exact query over the server's size limit
+    InternalError = 4   // The solver threw (e.g. out of memory)
+};
+
+constexpr uint8_t kNoCache = 1;     // Flag: bypass the result cache
+
+struct RequestFrame {
+    uint32_t id;            // Echoed in the response
+    uint8_t op;
+    uint8_t flags;
+    uint16_t reserved;
+    uint32_t instance;      // Coverage instance or point set index
+    int32_t k;              // Greedy / Exact only
+};
+
+struct ResponseHeader {
+    uint32_t id;
+    uint8_t op;
+    uint8_t status;
+    uint16_t reserved;
+    uint32_t payload_bytes;
+    uint32_t server_us;     // Time from receipt to response, queueing included
+};
+
+static_assert(sizeof(RequestFrame) == 16, "RequestFrame must be 16 bytes");
+static_assert(sizeof(ResponseHeader) == 16, "ResponseHeader must be 16 bytes");
+
+/**
+ * @brief Write all of buf, retrying on short writes and EINTR
+ */
+inline bool write_full(int fd, const void* buf, size_t bytes) {
+    const char* p = static_cast<const char*>(buf);
+    while (bytes > 0) {
+        ssize_t n = ::write(fd, p, bytes);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        bytes -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Read exactly bytes into buf; false on EOF or error
+ */
+inline bool read_full(int fd, void* buf, size_t bytes) {
+    char* p = static_cast<char*>(buf);
+    while (bytes > 0) {
+        ssize_t n = ::read(fd, p, bytes);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        bytes -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Append the raw bytes of a trivially copyable value
+ */
+template <typename T>
+void append(std::vector<char>& out, const T& value) {
+    const char* p = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+/**
+ * @brief Read a value at offset and advance it; false if out of range
+ */
+template <typename T>
+bool extract(const std::vector<char>& in, size_t& offset, T& value) {
+    if (offset + sizeof(T) > in.size()) return false;
+    std::memcpy(&value, in.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+} // namespace protocol
+
+#endif // PROTOCOL_H
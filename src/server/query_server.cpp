@@ -0,0 +1,236 @@
+#include "query_server.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace protocol;
+
+namespace {
+
+long long now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Limits of brute_force_max_coverage
+const int kExactMaxUsers = 20;
+const int kExactMaxK = 15;
+
+void append_coverage(std::vector<char>& payload, const CoverageResult& r) {
+    append(payload, static_cast<int32_t>(r.coverage));
+    append(payload, static_cast<int32_t>(r.selected_users.size()));
+    for (int u : r.selected_users) append(payload, static_cast<int32_t>(u));
+}
+
+} // namespace
+
+QueryServer::QueryServer(const ServerConfig& config)
+    : config(config),
+      coverage_cache(config.cache_capacity),
+      closest_pair_cache(config.cache_capacity),
+      pool(config.workers) {}
+
+int QueryServer::add_coverage_instance(std::vector<User> users) {
+    uint64_t key = fingerprint(users);
+    coverage.push_back({std::move(users), key});
+    return static_cast<int>(coverage.size()) - 1;
+}
+
+int QueryServer::add_point_set(std::vector<Point> points) {
+    uint64_t key = fingerprint(points);
+    point_sets.push_back({std::move(points), key});
+    return static_cast<int>(point_sets.size()) - 1;
+}
+
+const LatencyHistogram& QueryServer::latency(Op op) const {
+    return histograms[static_cast<int>(op) - 1];
+}
+
+bool QueryServer::run() {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (config.socket_path.size() >= sizeof(addr.sun_path)) return false;
+    std::strcpy(addr.sun_path, config.socket_path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    ::unlink(config.socket_path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(fd, 128) < 0) {
+        ::close(fd);
+        return false;
+    }
+    listen_fd = fd;
+
+    while (!stopping) {
+        int client = ::accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;          // Listener shut down by stop()
+        }
+        reap_connections();
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        connections.emplace_back(client);
+        Connection* connection = &connections.back();
+        connection->thread = std::thread(&QueryServer::serve_connection, this, connection);
+    }
+
+    listen_fd = -1;
+    ::close(fd);
+    ::unlink(config.socket_path.c_str());
+
+    // Wake the connection threads blocked in read(); each closes its own fd
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        for (const Connection& c : connections) {
+            if (!c.done) ::shutdown(c.fd, SHUT_RDWR);
+        }
+    }
+    for (Connection& c : connections) c.thread.join();
+    connections.clear();
+    return true;
+}
+
+void QueryServer::reap_connections() {
+    std::list<Connection> finished;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        for (auto it = connections.begin(); it != connections.end();) {
+            auto next = std::next(it);
+            if (it->done) finished.splice(finished.end(), connections, it);
+            it = next;
+        }
+    }
+    for (Connection& c : finished) c.thread.join();
+}
+
+void QueryServer::stop() {
+    stopping = true;
+    int fd = listen_fd.load();
+    if (fd >= 0) ::shutdown(fd, SHUT_RDWR);
+}
+
+void QueryServer::serve_connection(Connection* connection) {
+    const int fd = connection->fd;
+    const size_t capacity = std::max(1, config.max_batch) * sizeof(RequestFrame);
+    std::vector<char> buffer(capacity);
+    size_t filled = 0;
+    std::vector<RequestFrame> batch;
+    std::vector<std::future<std::vector<char>>> pending;
+    std::vector<char> out;
+
+    for (;;) {
+        ssize_t n = ::read(fd, buffer.data() + filled, capacity - filled);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        filled += n;
+        long long received = now_ns();
+
+        // Every complete frame that has arrived is one batch
+        size_t frames = filled / sizeof(RequestFrame);
+        if (frames == 0) continue;
+        batch.resize(frames);
+        std::memcpy(batch.data(), buffer.data(), frames * sizeof(RequestFrame));
+        size_t rest = filled - frames * sizeof(RequestFrame);
+        std::memmove(buffer.data(), buffer.data() + frames * sizeof(RequestFrame), rest);
+        filled = rest;
+
+        pending.clear();
+        for (const RequestFrame& request : batch) {
+            pending.push_back(pool.submit([this, request, received] { return execute(request, received); }));
+        }
+        out.clear();
+        for (auto& f : pending) {
+            std::vector<char> response = f.get();
+            out.insert(out.end(), response.begin(), response.end());
+        }
+        if (!write_full(fd, out.data(), out.size())) break;
+    }
+
+    std::lock_guard<std::mutex> lock(connections_mutex);
+    ::close(fd);
+    connection->done = true;
+}
+
+std::vector<char> QueryServer::execute(const RequestFrame& request, long long received_ns) {
+    ResponseHeader header{request.id, request.op, static_cast<uint8_t>(Status::Ok), 0, 0, 0};
+    std::vector<char> payload;
+    const bool cached = !(request.flags & kNoCache);
+    Status status = Status::Ok;
+
+    try {
+        switch (static_cast<Op>(request.op)) {
+            case Op::Greedy:
+            case Op::Exact: {
+                if (request.instance >= coverage.size()) {
+                    status = Status::UnknownInstance;
+                    break;
+                }
+                if (request.k < 0) {
+                    status = Status::BadRequest;
+                    break;
+                }
+                const CoverageInstance& instance = coverage[request.instance];
+                const int k = std::min<int>(request.k, instance.users.size());     // More picks than users: same answer
+                if (static_cast<Op>(request.op) == Op::Greedy) {
+                    append_coverage(payload, cached ? coverage_cache.solve(instance.key, instance.users, k)
+                                                    : greedy_max_coverage(instance.users, k));
+                } else if (static_cast<int>(instance.users.size()) > kExactMaxUsers || k > kExactMaxK) {
+                    status = Status::TooLarge;
+                } else {
+                    append_coverage(payload, brute_force_max_coverage(instance.users, k));
+                }
+                break;
+            }
+            case Op::ClosestPair: {
+                if (request.instance >= point_sets.size()) {
+                    status = Status::UnknownInstance;
+                    break;
+                }
+                const PointSet& set = point_sets[request.instance];
+                ClosestPairResult r = cached ? closest_pair_cache.solve(set.key, set.points)
+                                             : divide_conquer_closest_pair(set.points);
+                append(payload, r.distance);
+                append(payload, static_cast<int32_t>(r.p1.id));
+                append(payload, static_cast<int32_t>(r.p2.id));
+                break;
+            }
+            case Op::Info: {
+                append(payload, static_cast<uint32_t>(coverage.size()));
+                append(payload, static_cast<uint32_t>(point_sets.size()));
+                for (const auto& c : coverage) append(payload, static_cast<uint32_t>(c.users.size()));
+                for (const auto& p : point_sets) append(payload, static_cast<uint32_t>(p.points.size()));
+                break;
+            }
+            case Op::Stats: {
+                for (const LatencyHistogram& h : histograms) {
+                    append(payload, static_cast<uint64_t>(h.count()));
+                    append(payload, static_cast<uint64_t>(h.percentile_ns(0.5)));
+                    append(payload, static_cast<uint64_t>(h.percentile_ns(0.99)));
+                    append(payload, static_cast<uint64_t>(h.max_ns()));
+                }
+                break;
+            }
+            default:
+                status = Status::BadRequest;
+        }
+    } catch (const std::exception&) {
+        status = Status::InternalError;
+    }
+
+    long long elapsed = now_ns() - received_ns;
+    if (request.op >= 1 && request.op <= kQueryOps) histograms[request.op - 1].record(elapsed);
+
+    if (status != Status::Ok) payload.clear();
+    header.status = static_cast<uint8_t>(status);
+    header.payload_bytes = payload.size();
+    header.server_us = static_cast<uint32_t>(std::min<long long>(elapsed / 1000, UINT32_MAX));
+
+    std::vector<char> response;
+    response.reserve(sizeof(header) + payload.size());
+    append(response, header);
+    response.insert(response.end(), payload.begin(), payload.end());
+    return response;
+}
@@ -0,0 +1,122 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include "protocol.h"
+#include "../greedy/coverage_cache.h"
+#include "../divide_conquer/closest_pair_cache.h"
+#include "../common/latency_histogram.h"
+#include "../common/thread_pool.h"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Configuration of a QueryServer
+ */
+struct ServerConfig {
+    std::string socket_path = "/tmp/lbsn_query.sock";
+    int workers = 0;                // Solver threads (0 = hardware threads)
+    int max_batch = 64;             // Requests taken from one read at most
+    size_t cache_capacity = 64;     // Entries per result cache
+};
+
+/**
+ * @brief Resident query server over a Unix domain socket
+ *
+ * Instances are loaded once (add_coverage_instance / add_point_set, before
+ * run) with their fingerprints, and stay in memory for the server's life.
+ *
+ * Each connection has an I/O thread that reads whatever complete frames
+ * have arrived (up to max_batch) as one batch, submits every request of
+ * the batch to the shared worker pool, and writes all responses back in
+ * one write, in request order. Clients get batching by pipelining several
+ * requests per write. Greedy and closest-pair answers go through the
+ * fingerprint-keyed result caches unless the request sets kNoCache.
+ * Exact queries beyond brute_force_max_coverage's limits (n > 20 or
+ * k > 15) get Status::TooLarge; k above the instance size is clamped to
+ * it, and a query that throws gets Status::InternalError.
+ *
+ * Connection threads that have finished are joined by the accept loop,
+ * so a long-running server holds one thread per open connection only.
+ *
+ * Latency from receipt of a batch to its response is recorded per op.
+ */
+class QueryServer {
+public:
+    explicit QueryServer(const ServerConfig& config);
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    /**
+     * @brief Load a coverage instance; returns its index
+     */
+    int add_coverage_instance(std::vector<User> users);
+
+    /**
+     * @brief Load a point set; returns its index
+     */
+    int add_point_set(std::vector<Point> points);
+
+    /**
+     * @brief Bind the socket and serve until stop(); false if the socket could not be set up
+     *
+     * A client that disconnects mid-write raises SIGPIPE; callers should
+     * ignore it (signal(SIGPIPE, SIG_IGN)).
+     */
+    bool run();
+
+    /**
+     * @brief Make run() return (async-signal-safe: an atomic store and shutdown())
+     */
+    void stop();
+
+    /**
+     * @brief Server-side latency of one query op (Greedy, Exact or ClosestPair)
+     */
+    const LatencyHistogram& latency(protocol::Op op) const;
+
+    CacheStats coverage_cache_stats() const { return coverage_cache.stats(); }
+    CacheStats closest_pair_cache_stats() const { return closest_pair_cache.stats(); }
+
+private:
+    struct CoverageInstance {
+        std::vector<User> users;
+        uint64_t key;
+    };
+    struct PointSet {
+        std::vector<Point> points;
+        uint64_t key;
+    };
+    struct Connection {
+        int fd;
+        bool done = false;          // fd closed, thread about to exit (guarded by connections_mutex)
+        std::thread thread;
+
+        explicit Connection(int fd) : fd(fd) {}
+    };
+
+    ServerConfig config;
+    std::vector<CoverageInstance> coverage;
+    std::vector<PointSet> point_sets;
+    CoverageCache coverage_cache;
+    ClosestPairCache closest_pair_cache;
+    ThreadPool pool;
+    LatencyHistogram histograms[protocol::kQueryOps];
+
+    std::atomic<bool> stopping{false};
+    std::atomic<int> listen_fd{-1};
+    std::mutex connections_mutex;
+    std::list<Connection> connections;
+
+    void serve_connection(Connection* connection);
+    void reap_connections();
+    std::vector<char> execute(const protocol::RequestFrame& request, long long received_ns);
+};
+
+#endif // QUERY_SERVER_H
@@ -0,0 +1,70 @@
+#include "bichromatic_closest_pair.h"
+#include "kd_tree.h"
+#include "../divide_conquer/radix_sort.h"
+#include "../common/timer.h"
+#include <cmath>
+#include <limits>
+
+ClosestPairResult bichromatic_closest_pair(const std::vector<Point>& a, const std::vector<Point>& b) {
+    ClosestPairResult result;
+    result.distance = std::numeric_limits<double>::infinity();
+    result.runtime_ms = 0;
+    result.comparisons = 0;
+    if (a.empty() || b.empty()) return result;
+
+    Timer timer;
+    timer.start();
+
+    const bool index_a = a.size() <= b.size();
+    const std::vector<Point>& indexed = index_a ? a : b;
+    KdTree tree(indexed);
+
+    std::vector<Point> queries = index_a ? b : a;
+    radix_sort_points(queries, SortAxis::X);
+
+    Neighbor best{-1, std::numeric_limits<double>::infinity()};
+    int best_query = -1;
+    for (int q = 0; q < static_cast<int>(queries.size()); ++q) {
+        Neighbor nb = tree.nearest(queries[q].x, queries[q].y, -1, std::sqrt(best.dist2));
+        result.comparisons++;
+        if (nb.index >= 0 && nb.dist2 < best.dist2) {
+            best = nb;
+            best_query = q;
+        }
+    }
+
+    const Point& from_tree = indexed[best.index];
+    const Point& query = queries[best_query];
+    result.p1 = index_a ? from_tree : query;
+    result.p2 = index_a ? query : from_tree;
+    result.distance = distance(result.p1, result.p2);
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
+
+ClosestPairResult brute_force_bichromatic(const std::vector<Point>& a, const std::vector<Point>& b) {
+    ClosestPairResult result;
+    result.distance = std::numeric_limits<double>::infinity();
+    result.comparisons = 0;
+
+    Timer timer;
+    timer.start();
+
+    for (const Point& p : a) {
+        for (const Point& q : b) {
+            result.comparisons++;
+            double d = distance(p, q);
+            if (d < result.distance) {
+                result.distance = d;
+                result.p1 = p;
+                result.p2 = q;
+            }
+        }
+    }
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
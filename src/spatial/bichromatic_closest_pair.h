@@ -0,0 +1,42 @@
+#ifndef BICHROMATIC_CLOSEST_PAIR_H
+#define BICHROMATIC_CLOSEST_PAIR_H
+
+#include "../divide_conquer/closest_pair.h"
+#include <vector>
+
+/**
+ * @brief Closest pair with one point from each of two groups
+ *
+ * Algorithm:
+ * 1. Build a KdTree over the smaller group
+ * 2. Sort the larger group by x (radix sort) so consecutive queries stay
+ *    in the same part of the tree
+ * 3. Query each point of the larger group for its nearest neighbor in the
+ *    tree, strictly closer than the best cross pair found so far; most
+ *    queries are pruned at the first split they cannot beat
+ *
+ * Only cross pairs are ever measured. The strip argument of
+ * divide_conquer_closest_pair does not carry over: it relies on points of
+ * one side being pairwise >= δ apart, and same-color points can crowd a
+ * strip arbitrarily. Indexing the smaller group keeps imbalanced inputs
+ * cheap: with m = min(|A|, |B|) and n = max(|A|, |B|) the build is
+ * O(m log m) and the queries O(n log m).
+ *
+ * Time Complexity: O((|A| + |B|) log min(|A|, |B|)) expected
+ * Space Complexity: O(|A| + |B|)
+ *
+ * @param a First group (e.g. drivers)
+ * @param b Second group (e.g. riders)
+ * @return p1 from a and p2 from b; distance is infinity if a group is
+ *         empty; comparisons counts tree queries
+ */
+ClosestPairResult bichromatic_closest_pair(const std::vector<Point>& a, const std::vector<Point>& b);
+
+/**
+ * @brief Bichromatic closest pair by checking all |A|·|B| cross pairs
+ *
+ * Reference for bichromatic_closest_pair.
+ */
+ClosestPairResult brute_force_bichromatic(const std::vector<Point>& a, const std::vector<Point>& b);
+
+#endif // BICHROMATIC_CLOSEST_PAIR_H
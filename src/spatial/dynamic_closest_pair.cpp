@@ -0,0 +1,271 @@
+#include "dynamic_closest_pair.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// Rebuild with a smaller grid once the closest distance drops below h / kCrowding
+const double kCrowding = 8.0;
+
+} // namespace
+
+DynamicClosestPair::DynamicClosestPair(const std::vector<Point>& points) {
+    slots.reserve(points.size());
+    for (const auto& p : points) {
+        if (id_to_slot.count(p.id)) continue;
+        id_to_slot[p.id] = slots.size();
+        slots.push_back({p, 0, -1, kInfinity, true});
+        counters.inserts++;
+    }
+    rebuild();
+}
+
+std::uint64_t DynamicClosestPair::cell_of(double x, double y) const {
+    // Coordinates far outside ±2^31 cells wrap around; wrapped cells only add
+    // extra candidates, never hide a neighbor.
+    auto cx = static_cast<std::uint32_t>(static_cast<long long>(std::floor(x / h)));
+    auto cy = static_cast<std::uint32_t>(static_cast<long long>(std::floor(y / h)));
+    return (static_cast<std::uint64_t>(cx) << 32) | cy;
+}
+
+std::uint64_t DynamicClosestPair::neighbor_cell(std::uint64_t cell, int dx, int dy) {
+    std::uint32_t cx = static_cast<std::uint32_t>(cell >> 32) + dx;
+    std::uint32_t cy = static_cast<std::uint32_t>(cell) + dy;
+    return (static_cast<std::uint64_t>(cx) << 32) | cy;
+}
+
+void DynamicClosestPair::set_nn(int s, int nn, double dist) {
+    Slot& slot = slots[s];
+    if (slot.nn != -1) by_distance.erase({slot.nn_dist, s});
+    slot.nn = nn;
+    slot.nn_dist = dist;
+    if (nn != -1) by_distance.insert({dist, s});
+}
+
+/**
+ * @brief Recompute the local nearest neighbor of s from its 3x3 block
+ */
+void DynamicClosestPair::recompute_nn(int s) {
+    const Slot& slot = slots[s];
+    int best = -1;
+    double best_dist = kInfinity;
+
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            auto it = cells.find(neighbor_cell(slot.cell, dx, dy));
+            if (it == cells.end()) continue;
+            for (int q : it->second) {
+                if (q == s) continue;
+                counters.distance_evaluations++;
+                double d = distance(slot.p, slots[q].p);
+                if (d < best_dist) {
+                    best_dist = d;
+                    best = q;
+                }
+            }
+        }
+    }
+
+    set_nn(s, best, best_dist);
+}
+
+/**
+ * @brief Add slot s to the grid and update local nearest neighbors
+ *
+ * The 3x3 neighborhood relation is symmetric, so the only points whose
+ * local nn can change are the ones in s's own block.
+ */
+void DynamicClosestPair::link(int s) {
+    Slot& slot = slots[s];
+    slot.cell = cell_of(slot.p.x, slot.p.y);
+
+    int best = -1;
+    double best_dist = kInfinity;
+
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            auto it = cells.find(neighbor_cell(slot.cell, dx, dy));
+            if (it == cells.end()) continue;
+            for (int q : it->second) {
+                counters.distance_evaluations++;
+                double d = distance(slot.p, slots[q].p);
+                if (d < best_dist) {
+                    best_dist = d;
+                    best = q;
+                }
+                if (d < slots[q].nn_dist) {
+                    set_nn(q, s, d);
+                }
+            }
+        }
+    }
+
+    cells[slot.cell].push_back(s);
+    set_nn(s, best, best_dist);
+}
+
+/**
+ * @brief Remove slot s from the grid and repair neighbors that pointed to it
+ */
+void DynamicClosestPair::unlink(int s) {
+    Slot& slot = slots[s];
+
+    auto cell_it = cells.find(slot.cell);
+    auto& members = cell_it->second;
+    *std::find(members.begin(), members.end(), s) = members.back();
+    members.pop_back();
+    if (members.empty()) cells.erase(cell_it);
+
+    set_nn(s, -1, kInfinity);
+
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            auto it = cells.find(neighbor_cell(slot.cell, dx, dy));
+            if (it == cells.end()) continue;
+            for (int q : it->second) {
+                if (slots[q].nn == s) recompute_nn(q);
+            }
+        }
+    }
+}
+
+bool DynamicClosestPair::insert(const Point& p) {
+    if (id_to_slot.count(p.id)) return false;
+
+    int s;
+    if (!free_slots.empty()) {
+        s = free_slots.back();
+        free_slots.pop_back();
+        slots[s] = {p, 0, -1, kInfinity, true};
+    } else {
+        s = slots.size();
+        slots.push_back({p, 0, -1, kInfinity, true});
+    }
+    id_to_slot[p.id] = s;
+
+    link(s);
+    counters.inserts++;
+    updates_since_build++;
+    check_invariant();
+    return true;
+}
+
+bool DynamicClosestPair::erase(int id) {
+    auto it = id_to_slot.find(id);
+    if (it == id_to_slot.end()) return false;
+
+    int s = it->second;
+    id_to_slot.erase(it);
+    unlink(s);
+    slots[s].alive = false;
+    free_slots.push_back(s);
+
+    counters.erases++;
+    updates_since_build++;
+    check_invariant();
+    return true;
+}
+
+bool DynamicClosestPair::move(int id, double x, double y) {
+    auto it = id_to_slot.find(id);
+    if (it == id_to_slot.end()) return false;
+
+    // Re-link the same slot; the invariant is checked once at the end
+    int s = it->second;
+    unlink(s);
+    slots[s].p.x = x;
+    slots[s].p.y = y;
+    link(s);
+
+    counters.erases++;
+    counters.inserts++;
+    updates_since_build++;
+    check_invariant();
+    return true;
+}
+
+ClosestPairResult DynamicClosestPair::closest() const {
+    ClosestPairResult result;
+    result.distance = kInfinity;
+    result.runtime_ms = 0;
+    result.comparisons = 0;
+
+    if (size() < 2 || by_distance.empty()) return result;
+
+    int s = by_distance.begin()->second;
+    result.p1 = slots[s].p;
+    result.p2 = slots[slots[s].nn].p;
+    result.distance = slots[s].nn_dist;
+    return result;
+}
+
+/**
+ * @brief Rebuild when the grid no longer certifies the closest pair
+ *
+ * - No stored pair closer than h: the closest pair may span non-adjacent
+ *   cells, so the answer is not guaranteed (must rebuild)
+ * - Closest pair much smaller than h and many updates since the last
+ *   build: cells are crowded, rebuild to restore O(1) occupancy
+ */
+void DynamicClosestPair::check_invariant() {
+    if (size() < 2) return;
+
+    if (by_distance.empty() || by_distance.begin()->first >= h) {
+        rebuild();
+        return;
+    }
+
+    double best = by_distance.begin()->first;
+    if (best > 0 && best * kCrowding < h && updates_since_build > size() / 2) {
+        rebuild();
+    }
+}
+
+void DynamicClosestPair::rebuild() {
+    counters.rebuilds++;
+    updates_since_build = 0;
+
+    std::vector<Point> alive;
+    alive.reserve(id_to_slot.size());
+    for (const auto& slot : slots) {
+        if (slot.alive) alive.push_back(slot.p);
+    }
+
+    if (alive.size() >= 2) {
+        ClosestPairResult cp = divide_conquer_closest_pair(alive);
+        if (cp.distance > 0) {
+            h = 2 * cp.distance;
+        } else {
+            // Duplicate locations: any h certifies δ = 0, size cells by density
+            double min_x = alive[0].x, max_x = alive[0].x;
+            double min_y = alive[0].y, max_y = alive[0].y;
+            for (const auto& p : alive) {
+                min_x = std::min(min_x, p.x);
+                max_x = std::max(max_x, p.x);
+                min_y = std::min(min_y, p.y);
+                max_y = std::max(max_y, p.y);
+            }
+            double extent = std::max(max_x - min_x, max_y - min_y);
+            h = extent > 0 ? extent / std::sqrt((double)alive.size()) : 1.0;
+        }
+    }
+
+    cells.clear();
+    by_distance.clear();
+
+    for (size_t s = 0; s < slots.size(); ++s) {
+        Slot& slot = slots[s];
+        slot.nn = -1;
+        slot.nn_dist = kInfinity;
+        if (!slot.alive) continue;
+        slot.cell = cell_of(slot.p.x, slot.p.y);
+        cells[slot.cell].push_back(s);
+    }
+
+    for (size_t s = 0; s < slots.size(); ++s) {
+        if (slots[s].alive) recompute_nn(s);
+    }
+}
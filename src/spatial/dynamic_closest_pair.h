@@ -0,0 +1,129 @@
+#ifndef DYNAMIC_CLOSEST_PAIR_H
+#define DYNAMIC_CLOSEST_PAIR_H
+
+#include "../divide_conquer/closest_pair.h"
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Closest pair maintained under point insertions, deletions and moves
+ *
+ * Real problem: user locations change constantly, and re-running
+ * divide_conquer_closest_pair after every batch of moves re-sorts everything.
+ *
+ * Structure:
+ * - A hashed uniform grid with cell side h, where h > current closest distance
+ * - Every point stores its nearest neighbor among the 3x3 block of cells
+ *   around it (its "local" nearest neighbor)
+ * - An ordered set of (local nn distance, point) gives the minimum in O(1)
+ *
+ * Invariant: the true closest pair has distance < h, so both points lie in
+ * adjacent cells and the pair is some point's local nearest neighbor. The
+ * minimum local nn distance is therefore the exact closest distance.
+ *
+ * Updates:
+ * - insert: scan the 3x3 block once, set the new point's local nn and
+ *   adopt it as nn of any neighbor it is closer to
+ * - erase: neighbors whose nn was the erased point rescan their block
+ * - move: erase + insert
+ * - If the invariant breaks (closest pair removed and no pair < h remains)
+ *   or cells become crowded (closest distance << h), the grid is rebuilt
+ *   with h = 2·δ using divide_conquer_closest_pair
+ *
+ * Time Complexity (per update, expected amortized):
+ * - O(c + log n) where c is the number of points in the 3x3 block; with
+ *   h = Θ(δ) a cell holds O(1) points by the packing argument, and
+ *   rebuilds (O(n log n)) are spaced Ω(n) updates apart unless the
+ *   closest pair itself is repeatedly deleted
+ * - closest(): O(1)
+ *
+ * Space Complexity: O(n)
+ */
+class DynamicClosestPair {
+public:
+    /**
+     * @brief Counters describing the work done so far
+     */
+    struct Stats {
+        long long inserts = 0;
+        long long erases = 0;
+        long long rebuilds = 0;
+        long long distance_evaluations = 0;
+    };
+
+    DynamicClosestPair() = default;
+
+    /**
+     * @brief Build from an initial point set (ids must be unique)
+     */
+    explicit DynamicClosestPair(const std::vector<Point>& points);
+
+    /**
+     * @brief Insert a point; returns false if its id is already present
+     */
+    bool insert(const Point& p);
+
+    /**
+     * @brief Remove the point with the given id; returns false if absent
+     */
+    bool erase(int id);
+
+    /**
+     * @brief Move a point to (x, y); returns false if the id is absent
+     */
+    bool move(int id, double x, double y);
+
+    /**
+     * @brief Current closest pair in O(1)
+     *
+     * runtime_ms and comparisons are 0; distance is infinity if fewer
+     * than two points are stored.
+     */
+    ClosestPairResult closest() const;
+
+    /**
+     * @brief Number of points currently stored
+     */
+    int size() const { return static_cast<int>(id_to_slot.size()); }
+
+    /**
+     * @brief Current grid cell side h
+     */
+    double cell_size() const { return h; }
+
+    const Stats& stats() const { return counters; }
+
+private:
+    struct Slot {
+        Point p;
+        std::uint64_t cell;   // Packed grid cell key
+        int nn;               // Slot of local nearest neighbor, -1 if none
+        double nn_dist;       // Distance to it (infinity if none)
+        bool alive;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<int> free_slots;
+    std::unordered_map<int, int> id_to_slot;
+    std::unordered_map<std::uint64_t, std::vector<int>> cells;
+    std::set<std::pair<double, int>> by_distance;   // (nn_dist, slot) with nn != -1
+
+    double h = 1.0;
+    long long updates_since_build = 0;
+    Stats counters;
+
+    std::uint64_t cell_of(double x, double y) const;
+    static std::uint64_t neighbor_cell(std::uint64_t cell, int dx, int dy);
+
+    void set_nn(int s, int nn, double dist);
+    void recompute_nn(int s);
+    void link(int s);
+    void unlink(int s);
+    void check_invariant();
+    void rebuild();
+};
+
+#endif // DYNAMIC_CLOSEST_PAIR_H
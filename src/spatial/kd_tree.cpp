@@ -0,0 +1,136 @@
+#include "kd_tree.h"
+#include <algorithm>
+#include <numeric>
+
+KdTree::KdTree(const std::vector<Point>& points, int leaf_size) {
+    int n = points.size();
+    if (leaf_size < 1) leaf_size = 1;
+
+    // Leaf depth: halve until every bucket fits (sizes differ by at most 1)
+    int depth = 0;
+    while (((long long)n + (1LL << depth) - 1) >> depth > leaf_size) depth++;
+
+    int num_internal = (1 << depth) - 1;
+    first_leaf = num_internal;
+    split_value.assign(num_internal, 0.0);
+    split_dim.assign(num_internal, 0);
+
+    std::vector<int> perm(n);
+    std::iota(perm.begin(), perm.end(), 0);
+    if (n > 0) build(0, 0, n, perm, points);
+
+    xs.resize(n);
+    ys.resize(n);
+    index = std::move(perm);
+    for (int s = 0; s < n; ++s) {
+        xs[s] = points[index[s]].x;
+        ys[s] = points[index[s]].y;
+    }
+}
+
+/**
+ * @brief Median-split the range [lo, hi) of perm along its wider dimension
+ */
+void KdTree::build(int node, int lo, int hi, std::vector<int>& perm,
+                   const std::vector<Point>& points) {
+    if (node >= first_leaf) return;
+
+    double min_x = points[perm[lo]].x, max_x = min_x;
+    double min_y = points[perm[lo]].y, max_y = min_y;
+    for (int i = lo + 1; i < hi; ++i) {
+        const Point& p = points[perm[i]];
+        min_x = std::min(min_x, p.x);
+        max_x = std::max(max_x, p.x);
+        min_y = std::min(min_y, p.y);
+        max_y = std::max(max_y, p.y);
+    }
+
+    int dim = (max_y - min_y > max_x - min_x) ? 1 : 0;
+    int mid = lo + (hi - lo) / 2;
+
+    auto first = perm.begin() + lo;
+    auto nth = perm.begin() + mid;
+    auto last = perm.begin() + hi;
+    if (dim == 0) {
+        std::nth_element(first, nth, last,
+            [&](int a, int b) { return points[a].x < points[b].x; });
+        split_value[node] = points[*nth].x;
+    } else {
+        std::nth_element(first, nth, last,
+            [&](int a, int b) { return points[a].y < points[b].y; });
+        split_value[node] = points[*nth].y;
+    }
+    split_dim[node] = dim;
+
+    build(2 * node + 1, lo, mid, perm, points);
+    build(2 * node + 2, mid, hi, perm, points);
+}
+
+/**
+ * @brief Depth-first search, near child first, far child only if the
+ *        splitting line is closer than the current worst distance
+ */
+template <typename Visit>
+void KdTree::search(int node, int lo, int hi, double x, double y,
+                    double& worst, Visit& visit) const {
+    if (node >= first_leaf) {
+        for (int s = lo; s < hi; ++s) {
+            double dx = xs[s] - x, dy = ys[s] - y;
+            double d2 = dx * dx + dy * dy;
+            if (d2 < worst) visit(s, d2, worst);
+        }
+        return;
+    }
+
+    int mid = lo + (hi - lo) / 2;
+    double diff = (split_dim[node] == 0 ? x : y) - split_value[node];
+
+    if (diff < 0) {
+        search(2 * node + 1, lo, mid, x, y, worst, visit);
+        if (diff * diff < worst) search(2 * node + 2, mid, hi, x, y, worst, visit);
+    } else {
+        search(2 * node + 2, mid, hi, x, y, worst, visit);
+        if (diff * diff < worst) search(2 * node + 1, lo, mid, x, y, worst, visit);
+    }
+}
+
+int KdTree::knn(double x, double y, int k, int exclude, Neighbor* out) const {
+    if (k <= 0 || index.empty()) return 0;
+
+    auto farther = [](const Neighbor& a, const Neighbor& b) { return a.dist2 < b.dist2; };
+    int count = 0;
+    double worst = std::numeric_limits<double>::infinity();
+
+    // out[0..count) is a max-heap on dist2 while searching
+    auto visit = [&](int s, double d2, double& bound) {
+        if (index[s] == exclude) return;
+        if (count < k) {
+            out[count++] = {index[s], d2};
+            std::push_heap(out, out + count, farther);
+            if (count == k) bound = out[0].dist2;
+        } else {
+            std::pop_heap(out, out + k, farther);
+            out[k - 1] = {index[s], d2};
+            std::push_heap(out, out + k, farther);
+            bound = out[0].dist2;
+        }
+    };
+
+    search(0, 0, size(), x, y, worst, visit);
+    std::sort_heap(out, out + count, farther);
+    return count;
+}
+
+Neighbor KdTree::nearest(double x, double y, int exclude, double max_dist) const {
+    Neighbor best{-1, max_dist * max_dist};
+    double worst = best.dist2;
+
+    auto visit = [&](int s, double d2, double& bound) {
+        if (index[s] == exclude) return;
+        best = {index[s], d2};
+        bound = d2;
+    };
+
+    if (!index.empty()) search(0, 0, size(), x, y, worst, visit);
+    return best;
+}
@@ -0,0 +1,90 @@
+#ifndef KD_TREE_H
+#define KD_TREE_H
+
+#include "../divide_conquer/closest_pair.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief A neighbor returned by a k-d tree query
+ */
+struct Neighbor {
+    int index;      // Index into the vector the tree was built from
+    double dist2;   // Squared Euclidean distance to the query
+};
+
+/**
+ * @brief Static 2D k-d tree with implicit array layout and leaf buckets
+ *
+ * Layout:
+ * - Points are copied into coordinate arrays (xs, ys) and reordered so every
+ *   subtree is a contiguous range; leaves are buckets of <= leaf_size points
+ * - Every split is at the median, so all leaves sit at the same depth and the
+ *   tree is a complete binary tree: node i has children 2i+1 and 2i+2, and the
+ *   range of a node is recomputed on the way down (no child pointers, no
+ *   stored ranges)
+ * - Each internal node stores only its split dimension and split value
+ *
+ * Build Time: O(n log n) (nth_element per level)
+ * Query Time: O(log n + k) expected for well-spread data
+ * Space: O(n)
+ */
+class KdTree {
+public:
+    /**
+     * @brief Build the tree
+     * @param points Input points (copied; indices refer to this vector)
+     * @param leaf_size Maximum points per leaf bucket
+     */
+    explicit KdTree(const std::vector<Point>& points, int leaf_size = 16);
+
+    /**
+     * @brief k nearest neighbors of (x, y)
+     *
+     * Uses a bounded max-heap of size k, so the search prunes against the
+     * current k-th best distance.
+     *
+     * @param x Query x
+     * @param y Query y
+     * @param k Number of neighbors wanted
+     * @param exclude Input index to skip (the query point itself), or -1
+     * @param out Array with room for k neighbors, filled nearest-first
+     * @return Number of neighbors written (min(k, available points))
+     */
+    int knn(double x, double y, int k, int exclude, Neighbor* out) const;
+
+    /**
+     * @brief Nearest neighbor of (x, y) strictly closer than max_dist
+     *
+     * @return Neighbor with index -1 if no point is closer than max_dist
+     */
+    Neighbor nearest(double x, double y, int exclude = -1,
+                     double max_dist = std::numeric_limits<double>::infinity()) const;
+
+    /**
+     * @brief Input indices in tree (leaf) order
+     *
+     * Visiting queries in this order keeps consecutive searches on the same
+     * leaves, which is much friendlier to the cache than input order.
+     */
+    const std::vector<int>& order() const { return index; }
+
+    int size() const { return static_cast<int>(index.size()); }
+
+private:
+    std::vector<double> xs, ys;           // Coordinates in tree order
+    std::vector<int> index;               // Input index of each slot
+    std::vector<double> split_value;      // Per internal node
+    std::vector<std::uint8_t> split_dim;  // Per internal node (0 = x, 1 = y)
+    int first_leaf = 0;                   // Node id of the leftmost leaf
+
+    void build(int node, int lo, int hi, std::vector<int>& perm,
+               const std::vector<Point>& points);
+
+    template <typename Visit>
+    void search(int node, int lo, int hi, double x, double y,
+                double& worst, Visit& visit) const;
+};
+
+#endif // KD_TREE_H
@@ -0,0 +1,92 @@
+#include "knn_graph.h"
+#include "kd_tree.h"
+#include "../common/thread_pool.h"
+#include "../common/timer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+KnnGraph empty_graph(int n, int k) {
+    KnnGraph graph;
+    graph.k = std::max(0, std::min(k, n - 1));
+    graph.offsets.resize(n + 1);
+    for (int i = 0; i <= n; ++i) graph.offsets[i] = i * graph.k;
+    graph.neighbors.resize((size_t)n * graph.k);
+    graph.distances.resize((size_t)n * graph.k);
+    graph.build_ms = graph.query_ms = graph.runtime_ms = 0.0;
+    return graph;
+}
+
+} // namespace
+
+KnnGraph build_knn_graph(const std::vector<Point>& points, int k, int num_threads) {
+    Timer total;
+    total.start();
+
+    int n = points.size();
+    KnnGraph graph = empty_graph(n, k);
+    if (graph.k == 0) return graph;
+
+    Timer phase;
+    phase.start();
+    KdTree tree(points);
+    phase.stop();
+    graph.build_ms = phase.elapsed_ms();
+
+    phase.start();
+    if (num_threads <= 0) num_threads = ThreadPool::hardware_threads();
+
+    const int kk = graph.k;
+    const std::vector<int>& order = tree.order();
+    std::vector<std::vector<Neighbor>> heaps(num_threads, std::vector<Neighbor>(kk));
+
+    parallel_for(0, n, num_threads, [&](long long slot, int worker) {
+        int i = order[slot];
+        Neighbor* heap = heaps[worker].data();
+        int found = tree.knn(points[i].x, points[i].y, kk, i, heap);
+
+        int* nbr = graph.neighbors.data() + (size_t)i * kk;
+        double* dist = graph.distances.data() + (size_t)i * kk;
+        for (int j = 0; j < found; ++j) {
+            nbr[j] = heap[j].index;
+            dist[j] = std::sqrt(heap[j].dist2);
+        }
+    }, 1024);
+
+    phase.stop();
+    graph.query_ms = phase.elapsed_ms();
+
+    total.stop();
+    graph.runtime_ms = total.elapsed_ms();
+    return graph;
+}
+
+KnnGraph brute_force_knn_graph(const std::vector<Point>& points, int k) {
+    Timer timer;
+    timer.start();
+
+    int n = points.size();
+    KnnGraph graph = empty_graph(n, k);
+    int kk = graph.k;
+
+    std::vector<std::pair<double, int>> candidates;
+    candidates.reserve(n);
+
+    for (int i = 0; i < n && kk > 0; ++i) {
+        candidates.clear();
+        for (int j = 0; j < n; ++j) {
+            if (j != i) candidates.emplace_back(distance(points[i], points[j]), j);
+        }
+        std::partial_sort(candidates.begin(), candidates.begin() + kk, candidates.end());
+        for (int j = 0; j < kk; ++j) {
+            graph.neighbors[(size_t)i * kk + j] = candidates[j].second;
+            graph.distances[(size_t)i * kk + j] = candidates[j].first;
+        }
+    }
+
+    timer.stop();
+    graph.runtime_ms = timer.elapsed_ms();
+    graph.query_ms = graph.runtime_ms;
+    return graph;
+}
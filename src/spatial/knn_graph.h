@@ -0,0 +1,51 @@
+#ifndef KNN_GRAPH_H
+#define KNN_GRAPH_H
+
+#include "../divide_conquer/closest_pair.h"
+#include <vector>
+
+/**
+ * @brief k-nearest-neighbor graph in compressed sparse row (CSR) form
+ *
+ * The neighbors of point i are neighbors[offsets[i] .. offsets[i+1]),
+ * nearest first, with matching entries in distances. Indices refer to the
+ * input vector.
+ */
+struct KnnGraph {
+    int k;                          // Neighbors per point (min(k, n - 1))
+    std::vector<int> offsets;       // Size n + 1
+    std::vector<int> neighbors;     // Size n * k
+    std::vector<double> distances;  // Euclidean distances, size n * k
+    double build_ms;                // Time to build the k-d tree
+    double query_ms;                // Time to run all n queries
+    double runtime_ms;              // Total runtime in milliseconds
+};
+
+/**
+ * @brief All-k-nearest-neighbors graph via a static k-d tree
+ *
+ * Real problem: each user's k nearest other users, for proximity
+ * recommendations.
+ *
+ * Algorithm:
+ * 1. Build a KdTree (implicit layout, leaf buckets)
+ * 2. Run one bounded-heap k-NN query per point, in tree order so
+ *    consecutive queries reuse the same leaves, in parallel
+ * 3. Write results straight into the CSR arrays (each query owns its slice)
+ *
+ * Time Complexity: O(n log n + n·k·log k) expected
+ * Space Complexity: O(n·k) output + O(n) tree
+ *
+ * @param points Input points
+ * @param k Neighbors per point
+ * @param num_threads Worker threads (0 = hardware threads)
+ * @return CSR neighbor lists and timing
+ */
+KnnGraph build_knn_graph(const std::vector<Point>& points, int k, int num_threads = 0);
+
+/**
+ * @brief Brute force k-NN graph (O(n² log k)) for validation
+ */
+KnnGraph brute_force_knn_graph(const std::vector<Point>& points, int k);
+
+#endif // KNN_GRAPH_H
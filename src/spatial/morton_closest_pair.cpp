@@ -0,0 +1,250 @@
+#include "morton_closest_pair.h"
+#include "../divide_conquer/radix_sort.h"
+#include "../common/timer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+using radix_detail::KeyIndex;
+
+const int kGridBits = 30;
+const std::uint32_t kGridMax = (1u << kGridBits) - 1;
+const int kDims = 2;
+
+/**
+ * @brief Points snapped onto the 2^30 grid over their bounding box
+ */
+struct QuantizedPoints {
+    std::vector<std::uint32_t> qx, qy;
+    double step;    // World units per grid step
+};
+
+QuantizedPoints quantize(const std::vector<Point>& points) {
+    double min_x = points[0].x, max_x = points[0].x;
+    double min_y = points[0].y, max_y = points[0].y;
+    for (const auto& p : points) {
+        min_x = std::min(min_x, p.x);
+        max_x = std::max(max_x, p.x);
+        min_y = std::min(min_y, p.y);
+        max_y = std::max(max_y, p.y);
+    }
+
+    double extent = std::max(max_x - min_x, max_y - min_y);
+    QuantizedPoints q;
+    q.step = extent > 0 ? extent / kGridMax : 1.0;
+    q.qx.resize(points.size());
+    q.qy.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        q.qx[i] = std::min(kGridMax, static_cast<std::uint32_t>((points[i].x - min_x) / q.step));
+        q.qy[i] = std::min(kGridMax, static_cast<std::uint32_t>((points[i].y - min_y) / q.step));
+    }
+    return q;
+}
+
+/**
+ * @brief (Morton key of q + shift·(1, 1), index), sorted by key
+ */
+std::vector<KeyIndex> sorted_keys(const QuantizedPoints& q, std::uint32_t shift,
+                                  int num_threads) {
+    size_t n = q.qx.size();
+    std::vector<KeyIndex> keys(n), scratch(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = {morton_encode(q.qx[i] + shift, q.qy[i] + shift),
+                   static_cast<std::uint32_t>(i)};
+    }
+    radix_detail::radix_sort_keys(keys, scratch, num_threads);
+    return keys;
+}
+
+struct Cell { std::uint64_t key; int begin, end; };
+
+/**
+ * @brief Index of the cell with the given key, or -1 (galloping search)
+ *
+ * Cells are sorted by Morton key, and a neighboring cell is usually only a
+ * few positions away from the current one in that order, so searching
+ * outward from `from` touches O(log distance) cells that are mostly
+ * already in cache (a hash table costs a cache miss per lookup).
+ */
+int find_cell(const std::vector<Cell>& cells, int from, std::uint64_t key) {
+    const int m = cells.size();
+    int lo, hi;     // key is in cells[lo..hi) if present
+    if (cells[from].key < key) {
+        int step = 1;
+        lo = from + 1;
+        while (lo + step - 1 < m && cells[lo + step - 1].key < key) {
+            lo += step;
+            step <<= 1;
+        }
+        hi = std::min(m, lo + step);
+    } else {
+        int step = 1;
+        hi = from + 1;
+        while (hi - step >= 0 && cells[hi - step].key > key) {
+            hi -= step;
+            step <<= 1;
+        }
+        lo = std::max(0, hi - step);
+    }
+    auto it = std::lower_bound(cells.begin() + lo, cells.begin() + hi, key,
+        [](const Cell& c, std::uint64_t k) { return c.key < k; });
+    return (it != cells.begin() + hi && it->key == key) ? it - cells.begin() : -1;
+}
+
+int sort_threads(size_t n) {
+    return n >= radix_detail::kParallelMin ? ThreadPool::hardware_threads() : 1;
+}
+
+} // namespace
+
+MortonClosestPairResult morton_closest_pair(const std::vector<Point>& points,
+                                            double epsilon,
+                                            int window,
+                                            std::vector<int>* order) {
+    MortonClosestPairResult result{};
+    result.distance = std::numeric_limits<double>::infinity();
+    const int n = points.size();
+    if (n < 2) return result;
+
+    Timer timer, phase;
+    timer.start();
+    window = std::max(1, window);
+
+    const double c = 2.0 * (kDims + 1) * std::sqrt(static_cast<double>(kDims));
+    const int threads = sort_threads(n);
+
+    // Phase 1: quantize and sort by each shifted Morton key
+    phase.start();
+    QuantizedPoints q = quantize(points);
+    std::vector<std::vector<KeyIndex>> orders;
+    for (int j = 0; j <= kDims; ++j) {
+        std::uint32_t shift = static_cast<std::uint32_t>(j * ((kGridMax + 1ull) / (kDims + 1)));
+        orders.push_back(sorted_keys(q, shift, threads));
+    }
+    phase.stop();
+    result.sort_ms = phase.elapsed_ms();
+
+    // Phase 2: compare each point with its next successors in every order
+    phase.start();
+    double best = std::numeric_limits<double>::infinity();
+    int best_a = 0, best_b = 1;
+    auto consider = [&](int a, int b) {
+        result.comparisons++;
+        double dx = points[a].x - points[b].x, dy = points[a].y - points[b].y;
+        double d2 = dx * dx + dy * dy;
+        if (d2 < best) {
+            best = d2;
+            best_a = a;
+            best_b = b;
+        }
+    };
+    for (const auto& keys : orders) {
+        for (int i = 0; i + 1 < n; ++i) {
+            int last = std::min(n - 1, i + window);
+            for (int j = i + 1; j <= last; ++j) consider(keys[i].index, keys[j].index);
+        }
+    }
+    phase.stop();
+    result.scan_ms = phase.elapsed_ms();
+
+    result.approximation_bound = c;
+    result.additive_error = (c + 1.0) * std::sqrt(2.0) * q.step;
+    result.exact = (best == 0.0);
+
+    // Phase 3: exact refinement on a grid with cell side >= the approximate distance
+    if (!result.exact && 1.0 + epsilon < c) {
+        phase.start();
+        const std::vector<KeyIndex>& base = orders[0];
+
+        // Points within sqrt(best) differ by <= sqrt(best)/step + 1 grid steps per axis
+        double needed = std::sqrt(best) / q.step + 1.0;
+        int b = 0;
+        while (b < kGridBits + 1 && static_cast<double>(1ull << b) < needed) b++;
+
+        std::vector<Cell> cells;
+        for (int i = 0; i < n; ++i) {
+            std::uint64_t key = base[i].key >> (2 * b);
+            if (cells.empty() || cells.back().key != key) {
+                if (!cells.empty()) cells.back().end = i;
+                cells.push_back({key, i, i});
+            }
+        }
+        cells.back().end = n;
+
+        // Forward neighbors (dx, dy): each adjacent cell pair is visited once
+        static const int kOffsets[][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+        // Coordinates in Morton order: neighboring cells are close in memory
+        std::vector<double> xs(n), ys(n);
+        for (int i = 0; i < n; ++i) {
+            xs[i] = points[base[i].index].x;
+            ys[i] = points[base[i].index].y;
+        }
+        int slot_a = -1, slot_b = -1;
+        auto consider_slots = [&](int i, int j) {
+            result.comparisons++;
+            double dx = xs[i] - xs[j], dy = ys[i] - ys[j];
+            double d2 = dx * dx + dy * dy;
+            if (d2 < best) {
+                best = d2;
+                slot_a = i;
+                slot_b = j;
+            }
+        };
+
+        for (int c = 0; c < (int)cells.size(); ++c) {
+            const Cell& cell = cells[c];
+            for (int i = cell.begin; i < cell.end; ++i) {
+                for (int j = i + 1; j < cell.end; ++j) consider_slots(i, j);
+            }
+
+            std::uint32_t cx = q.qx[base[cell.begin].index] >> b;
+            std::uint32_t cy = q.qy[base[cell.begin].index] >> b;
+            for (const auto& off : kOffsets) {
+                if (off[0] < 0 && cx == 0) continue;
+                int k = find_cell(cells, c, morton_encode(cx + off[0], cy + off[1]));
+                if (k < 0) continue;
+
+                const Cell& other = cells[k];
+                for (int i = cell.begin; i < cell.end; ++i) {
+                    for (int j = other.begin; j < other.end; ++j) consider_slots(i, j);
+                }
+            }
+        }
+        if (slot_a >= 0) {
+            best_a = base[slot_a].index;
+            best_b = base[slot_b].index;
+        }
+        phase.stop();
+        result.refine_ms = phase.elapsed_ms();
+        result.exact = true;
+    }
+
+    if (result.exact) {
+        result.approximation_bound = 1.0;
+        result.additive_error = 0.0;
+    }
+
+    if (order) {
+        order->resize(n);
+        for (int i = 0; i < n; ++i) (*order)[i] = orders[0][i].index;
+    }
+
+    timer.stop();
+    result.p1 = points[best_a];
+    result.p2 = points[best_b];
+    result.distance = std::sqrt(best);
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
+
+std::vector<int> morton_order(const std::vector<Point>& points) {
+    std::vector<int> order(points.size());
+    if (points.empty()) return order;
+
+    auto keys = sorted_keys(quantize(points), 0, sort_threads(points.size()));
+    for (size_t i = 0; i < keys.size(); ++i) order[i] = keys[i].index;
+    return order;
+}
@@ -0,0 +1,97 @@
+#ifndef MORTON_CLOSEST_PAIR_H
+#define MORTON_CLOSEST_PAIR_H
+
+#include "../divide_conquer/closest_pair.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Interleave the bits of x and y into a Z-order (Morton) key
+ *
+ * Bit i of x lands on bit 2i, bit i of y on bit 2i+1, so sorting by the key
+ * visits the quadtree cells in depth-first order. The spread is the usual
+ * shift-and-mask kernel (5 steps, no table, no branches).
+ */
+inline std::uint64_t morton_encode(std::uint32_t x, std::uint32_t y) {
+    auto spread = [](std::uint64_t v) {
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v << 8))  & 0x00FF00FF00FF00FFull;
+        v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0Full;
+        v = (v | (v << 2))  & 0x3333333333333333ull;
+        v = (v | (v << 1))  & 0x5555555555555555ull;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+/**
+ * @brief Result of the Morton-order closest pair
+ *
+ * Guarantee: distance <= approximation_bound · δ + additive_error, where δ
+ * is the true closest distance. additive_error comes from quantizing the
+ * coordinates onto a 2^30 grid and is negligible unless δ is within a few
+ * grid steps. With exact = true the pair is the exact closest pair.
+ */
+struct MortonClosestPairResult {
+    Point p1, p2;                   // The reported pair
+    double distance;                // Its (exact) distance
+    double approximation_bound;     // Multiplicative bound vs the true distance
+    double additive_error;          // Quantization term of the bound
+    bool exact;                     // Refined to the exact answer
+    double sort_ms;                 // Quantization and the shifted Morton sorts
+    double scan_ms;                 // Neighbor checks along each order
+    double refine_ms;               // Exact grid refinement (0 if skipped)
+    double runtime_ms;              // Total runtime in milliseconds
+    long long comparisons;          // Number of distance evaluations
+};
+
+/**
+ * @brief Approximate closest pair by neighbor checks in shifted Morton orders
+ *
+ * Algorithm:
+ * 1. Quantize points onto a 2^30 × 2^30 grid over the bounding box
+ * 2. For each of the d + 1 = 3 shifts v_j = j·2^30/3 · (1, 1), sort the
+ *    points by the Morton key of (q + v_j) (radix sort on 64-bit keys)
+ * 3. Compare each point with its next `window` successors in each order
+ *
+ * Bound (Chan's shifting lemma): for any p, q there is a shift j for which
+ * p + v_j and q + v_j lie in one quadtree cell of side <= 2(d+1)·|p-q|∞.
+ * A cell is a contiguous run of its Morton order, so some adjacent pair in
+ * that run is inside the cell, at distance <= its diameter. Hence the
+ * reported distance is at most c·δ with c = 2(d+1)·sqrt(d) = 6·sqrt(2).
+ *
+ * Refinement: if (1 + epsilon) < c, the approximate distance δ' is used as
+ * the cell size of a grid over the Morton-sorted points (cells of side 2^b
+ * are contiguous Morton prefixes). Every cell holds O(c²) points, since all
+ * points are pairwise >= δ >= δ'/c apart, so checking each cell against
+ * its forward neighbors is linear work and returns the exact pair.
+ * Neighbor cells are located by a galloping search from the current cell
+ * in Morton order, which is usually only a few cells away.
+ *
+ * Time Complexity: O(n) for the radix sorts, O(n · window) for the scans,
+ * O(n) distance evaluations plus O(log gap) per neighbor lookup for the
+ * refinement
+ *
+ * @param points Input points (not modified)
+ * @param epsilon Allowed relative error; the result satisfies
+ *        distance <= (1 + epsilon)·δ up to the quantization term
+ * @param window Successors checked per point in each order (>= 1); larger
+ *        windows tighten the typical error, not the worst-case bound
+ * @param order If not null, receives input indices in (unshifted) Morton
+ *        order, for reuse by other spatial passes
+ * @return Reported pair, bound and phase timings
+ */
+MortonClosestPairResult morton_closest_pair(const std::vector<Point>& points,
+                                            double epsilon,
+                                            int window = 2,
+                                            std::vector<int>* order = nullptr);
+
+/**
+ * @brief Input indices sorted by Morton key over the bounding box
+ *
+ * Visiting points in this order keeps spatially close points close in
+ * memory (the same order morton_closest_pair reports).
+ */
+std::vector<int> morton_order(const std::vector<Point>& points);
+
+#endif // MORTON_CLOSEST_PAIR_H
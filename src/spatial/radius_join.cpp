@@ -0,0 +1,234 @@
+#include "radius_join.h"
+#include "../common/thread_pool.h"
+#include "../common/timer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+namespace {
+
+/**
+ * @brief Points bucketed by grid cell, stored as contiguous runs
+ *
+ * Coordinates are kept in separate arrays (structure of arrays) so the
+ * pair kernel streams through x and y without touching ids.
+ */
+struct BucketedGrid {
+    std::vector<double> xs, ys;     // Coordinates in (row, column) order
+    std::vector<int> index;         // Original input index of each slot
+
+    struct Cell { long long cx; int begin, end; };
+    struct Row { long long cy; int cell_begin, cell_end; };
+
+    std::vector<Cell> cells;        // Non-empty cells, sorted by (row, column)
+    std::vector<Row> rows;          // Non-empty rows, sorted by row
+};
+
+BucketedGrid build_grid(const std::vector<Point>& points, double cell_size) {
+    int n = points.size();
+
+    double min_x = points[0].x, min_y = points[0].y;
+    for (const auto& p : points) {
+        min_x = std::min(min_x, p.x);
+        min_y = std::min(min_y, p.y);
+    }
+
+    std::vector<long long> cell_x(n), cell_y(n);
+    for (int i = 0; i < n; ++i) {
+        cell_x[i] = static_cast<long long>(std::floor((points[i].x - min_x) / cell_size));
+        cell_y[i] = static_cast<long long>(std::floor((points[i].y - min_y) / cell_size));
+    }
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return cell_y[a] < cell_y[b] || (cell_y[a] == cell_y[b] && cell_x[a] < cell_x[b]);
+    });
+
+    BucketedGrid grid;
+    grid.xs.resize(n);
+    grid.ys.resize(n);
+    grid.index.resize(n);
+
+    for (int s = 0; s < n; ++s) {
+        int i = order[s];
+        grid.xs[s] = points[i].x;
+        grid.ys[s] = points[i].y;
+        grid.index[s] = i;
+
+        bool new_row = (s == 0) || cell_y[i] != cell_y[order[s - 1]];
+        bool new_cell = new_row || cell_x[i] != cell_x[order[s - 1]];
+
+        if (new_cell) {
+            if (!grid.cells.empty()) grid.cells.back().end = s;
+            grid.cells.push_back({cell_x[i], s, s});
+        }
+        if (new_row) {
+            if (!grid.rows.empty()) grid.rows.back().cell_end = grid.cells.size() - 1;
+            grid.rows.push_back({cell_y[i], (int)grid.cells.size() - 1, 0});
+        }
+    }
+    grid.cells.back().end = n;
+    grid.rows.back().cell_end = grid.cells.size();
+
+    return grid;
+}
+
+/**
+ * @brief Join driver shared by the callback and buffer entry points
+ *
+ * emit(worker, pair) is invoked for every pair with distance <= r.
+ */
+template <typename Emit>
+RadiusJoinResult run_join(const std::vector<Point>& points, double r,
+                          int num_threads, Emit&& emit) {
+    RadiusJoinResult result{0, 0, 0, 0.0, 0.0};
+    if (points.size() < 2 || !(r > 0)) return result;
+
+    Timer timer;
+    timer.start();
+
+    // Cell diagonal equals r: every same-cell pair is part of the output,
+    // and a partner within r is at most 2 cells away in each direction.
+    const double cell_size = r / std::sqrt(2.0);
+    const double r2 = r * r;
+    BucketedGrid grid = build_grid(points, cell_size);
+
+    if (num_threads <= 0) num_threads = ThreadPool::hardware_threads();
+    int rows = grid.rows.size();
+    num_threads = std::max(1, std::min(num_threads, rows));
+
+    // Per-worker counters, padded to avoid false sharing
+    struct alignas(64) Counters { long long pairs = 0, candidates = 0; };
+    std::vector<Counters> counters(num_threads);
+
+    // Forward neighbor offsets (dy, dx). Corners (±2, ±2) are always
+    // farther than r apart and are skipped.
+    static const int kOffsets[][2] = {
+        {0, 1}, {0, 2},
+        {1, -2}, {1, -1}, {1, 0}, {1, 1}, {1, 2},
+        {2, -1}, {2, 0}, {2, 1}
+    };
+
+    const double* xs = grid.xs.data();
+    const double* ys = grid.ys.data();
+    const int* index = grid.index.data();
+
+    auto process_row = [&](long long row_idx, int worker) {
+        Counters& cnt = counters[worker];
+        const BucketedGrid::Row& row = grid.rows[row_idx];
+
+        // Rows reachable from this one (dy = 0, 1, 2), -1 if empty
+        int row_of[3] = {static_cast<int>(row_idx), -1, -1};
+        for (int k = 1; k <= 2 && row_idx + k < rows; ++k) {
+            long long dy = grid.rows[row_idx + k].cy - row.cy;
+            if (dy <= 2) row_of[dy] = row_idx + k;
+        }
+
+        for (int c = row.cell_begin; c < row.cell_end; ++c) {
+            const BucketedGrid::Cell& cell = grid.cells[c];
+
+            // Pairs inside the cell
+            for (int i = cell.begin; i < cell.end; ++i) {
+                for (int j = i + 1; j < cell.end; ++j) {
+                    cnt.candidates++;
+                    double dx = xs[i] - xs[j], dy = ys[i] - ys[j];
+                    double d2 = dx * dx + dy * dy;
+                    if (d2 <= r2) {
+                        cnt.pairs++;
+                        emit(worker, RadiusPair{index[i], index[j], std::sqrt(d2)});
+                    }
+                }
+            }
+
+            // Pairs with forward neighbor cells
+            for (const auto& off : kOffsets) {
+                int nr = row_of[off[0]];
+                if (nr < 0) continue;
+
+                const BucketedGrid::Row& other = grid.rows[nr];
+                long long target = cell.cx + off[1];
+                auto first = grid.cells.begin() + other.cell_begin;
+                auto last = grid.cells.begin() + other.cell_end;
+                auto it = std::lower_bound(first, last, target,
+                    [](const BucketedGrid::Cell& a, long long cx) { return a.cx < cx; });
+                if (it == last || it->cx != target) continue;
+
+                for (int i = cell.begin; i < cell.end; ++i) {
+                    for (int j = it->begin; j < it->end; ++j) {
+                        cnt.candidates++;
+                        double dx = xs[i] - xs[j], dy = ys[i] - ys[j];
+                        double d2 = dx * dx + dy * dy;
+                        if (d2 <= r2) {
+                            cnt.pairs++;
+                            emit(worker, RadiusPair{index[i], index[j], std::sqrt(d2)});
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    parallel_for(0, rows, num_threads, process_row);
+
+    for (const auto& c : counters) {
+        result.pairs += c.pairs;
+        result.candidates += c.candidates;
+    }
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    result.pairs_per_second = result.runtime_ms > 0
+        ? result.pairs / (result.runtime_ms / 1000.0) : 0.0;
+    return result;
+}
+
+} // namespace
+
+RadiusJoinResult radius_join(const std::vector<Point>& points, double r,
+                             const RadiusPairCallback& callback,
+                             int num_threads) {
+    return run_join(points, r, num_threads,
+        [&](int worker, const RadiusPair& pair) { callback(worker, pair); });
+}
+
+RadiusJoinResult radius_join_into(const std::vector<Point>& points, double r,
+                                  RadiusPair* buffer, std::size_t capacity,
+                                  int num_threads) {
+    std::atomic<std::size_t> next(0);
+    RadiusJoinResult result = run_join(points, r, num_threads,
+        [&](int, const RadiusPair& pair) {
+            std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+            if (slot < capacity) buffer[slot] = pair;
+        });
+    result.pairs_written = std::min<long long>(result.pairs, capacity);
+    return result;
+}
+
+RadiusJoinResult brute_force_radius_join(const std::vector<Point>& points, double r,
+                                         const RadiusPairCallback& callback) {
+    Timer timer;
+    timer.start();
+
+    RadiusJoinResult result{0, 0, 0, 0.0, 0.0};
+    int n = points.size();
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            result.candidates++;
+            double dist = distance(points[i], points[j]);
+            if (dist <= r) {
+                result.pairs++;
+                callback(0, RadiusPair{i, j, dist});
+            }
+        }
+    }
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    result.pairs_per_second = result.runtime_ms > 0
+        ? result.pairs / (result.runtime_ms / 1000.0) : 0.0;
+    return result;
+}
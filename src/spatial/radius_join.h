@@ -0,0 +1,100 @@
+#ifndef RADIUS_JOIN_H
+#define RADIUS_JOIN_H
+
+#include "../divide_conquer/closest_pair.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief One reported pair of the fixed-radius join
+ */
+struct RadiusPair {
+    int a, b;               // Indices into the input vector (a != b)
+    double distance;        // Euclidean distance between them (<= r)
+};
+
+/**
+ * @brief Result of a fixed-radius all-pairs join
+ */
+struct RadiusJoinResult {
+    long long pairs;            // Number of pairs within distance r
+    long long pairs_written;    // Pairs stored in the output buffer (buffer mode only)
+    long long candidates;       // Number of distance evaluations made
+    double runtime_ms;          // Runtime in milliseconds
+    double pairs_per_second;    // Output throughput
+};
+
+/**
+ * @brief Callback receiving each pair within distance r
+ *
+ * The first argument is the id of the worker thread that found the pair
+ * (0 <= worker < num_threads), so callers can keep per-thread accumulators
+ * without locking. With num_threads > 1 the callback runs concurrently.
+ */
+using RadiusPairCallback = std::function<void(int worker, const RadiusPair& pair)>;
+
+/**
+ * @brief Report every pair of points within distance r (uniform grid)
+ *
+ * Real problem: "all pairs of users within r meters of each other".
+ *
+ * Algorithm:
+ * 1. Bucket points into a grid of square cells with side r/sqrt(2), so any
+ *    two points sharing a cell are within r of each other
+ * 2. Sort points by (row, column) so every cell is a contiguous run
+ * 3. For each cell, compare against itself and the 10 "forward" neighbor
+ *    cells that can hold points within r (each cell pair visited once)
+ * 4. Rows are processed in parallel, handed out dynamically
+ *
+ * Time Complexity: O(n log n + output)
+ * - Pairs inside a cell are all reported, so a cell of m points costs
+ *   Θ(m²) work and yields Θ(m²) output
+ * - A neighbor cell pair (A, B) costs |A|·|B| <= (|A|² + |B|²) / 2, which is
+ *   charged to the in-cell output of A and B. Dense clusters therefore never
+ *   cost more than a constant times the output size.
+ *
+ * Space Complexity: O(n) for the bucketed copy of the points
+ *
+ * @param points Input points (not modified)
+ * @param r Join radius (pairs with distance <= r are reported)
+ * @param callback Called once per unordered pair
+ * @param num_threads Worker threads (0 = hardware threads)
+ * @return Pair count, work counters and throughput
+ */
+RadiusJoinResult radius_join(const std::vector<Point>& points, double r,
+                             const RadiusPairCallback& callback,
+                             int num_threads = 1);
+
+/**
+ * @brief Fixed-radius join writing pairs into a caller-provided buffer
+ *
+ * Pairs are written in an unspecified order. If the buffer is too small the
+ * join still counts every pair: result.pairs is the full output size and
+ * result.pairs_written == capacity, so callers can resize and retry.
+ *
+ * @param points Input points (not modified)
+ * @param r Join radius
+ * @param buffer Output array with room for capacity pairs
+ * @param capacity Number of pairs the buffer can hold
+ * @param num_threads Worker threads (0 = hardware threads)
+ * @return Pair count, written count, work counters and throughput
+ */
+RadiusJoinResult radius_join_into(const std::vector<Point>& points, double r,
+                                  RadiusPair* buffer, std::size_t capacity,
+                                  int num_threads = 1);
+
+/**
+ * @brief Brute force fixed-radius join (O(n²))
+ *
+ * Reference implementation for validating the grid join.
+ *
+ * @param points Input points
+ * @param r Join radius
+ * @param callback Called once per unordered pair (worker is always 0)
+ * @return Pair count and timing
+ */
+RadiusJoinResult brute_force_radius_join(const std::vector<Point>& points, double r,
+                                         const RadiusPairCallback& callback);
+
+#endif // RADIUS_JOIN_H
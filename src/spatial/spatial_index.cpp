@@ -0,0 +1,194 @@
+#include "spatial_index.h"
+#include "morton_closest_pair.h"
+#include "../divide_conquer/closest_pair_engine.h"
+#include "../divide_conquer/radix_sort.h"
+#include "../common/timer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+using radix_detail::KeyIndex;
+
+/**
+ * @brief Sort (rank, index) pairs by rank: radix for large subsets
+ */
+void sort_by_rank(std::vector<KeyIndex>& keys) {
+    if (keys.size() < radix_detail::kRadixMin) {
+        std::sort(keys.begin(), keys.end(),
+            [](const KeyIndex& a, const KeyIndex& b) { return a.key < b.key; });
+        return;
+    }
+    std::vector<KeyIndex> scratch(keys.size());
+    radix_detail::radix_sort_keys(keys, scratch, 1);
+}
+
+} // namespace
+
+SpatialIndex::SpatialIndex(const std::vector<Point>& input) : points(input) {
+    const int n = points.size();
+    if (n == 0) return;
+
+    // Precomputed ranks in compare_x order
+    std::vector<int> order_x(n);
+    for (int i = 0; i < n; ++i) order_x[i] = i;
+    radix_sort_by(order_x,
+        [&](int i) { return points[i].x; },
+        [&](int a, int b) {
+            return points[a].x < points[b].x ||
+                   (points[a].x == points[b].x && points[a].y < points[b].y);
+        });
+
+    sorted_x.resize(n);
+    x_rank.resize(n);
+    for (int r = 0; r < n; ++r) {
+        sorted_x[r] = points[order_x[r]];
+        x_rank[order_x[r]] = r;
+    }
+
+    id_to_index.reserve(n);
+    for (int i = 0; i < n; ++i) id_to_index.emplace(points[i].id, i);
+
+    // Hierarchical grid: square root cell over the bounding box
+    min_x = sorted_x.front().x;
+    min_y = points[0].y;
+    double max_y = points[0].y;
+    for (const auto& p : points) {
+        min_y = std::min(min_y, p.y);
+        max_y = std::max(max_y, p.y);
+    }
+    double extent = std::max(sorted_x.back().x - min_x, max_y - min_y);
+    side = extent > 0 ? extent : 1.0;
+
+    depth = 0;
+    while (depth < kMaxDepth && (1LL << (2 * depth)) * kLeafSize < n) depth++;
+    const std::uint32_t cells_per_axis = 1u << depth;
+    const double finest = side / cells_per_axis;
+
+    std::vector<std::uint32_t> code(n);
+    for (int i = 0; i < n; ++i) {
+        auto cx = std::min<std::uint32_t>(cells_per_axis - 1,
+            static_cast<std::uint32_t>((points[i].x - min_x) / finest));
+        auto cy = std::min<std::uint32_t>(cells_per_axis - 1,
+            static_cast<std::uint32_t>((points[i].y - min_y) / finest));
+        code[i] = static_cast<std::uint32_t>(morton_encode(cx, cy));
+    }
+
+    // Counting sort by finest-cell Morton code
+    cell_start.assign((1u << (2 * depth)) + 1, 0);
+    for (int i = 0; i < n; ++i) cell_start[code[i] + 1]++;
+    for (size_t c = 1; c < cell_start.size(); ++c) cell_start[c] += cell_start[c - 1];
+
+    grid_order.resize(n);
+    std::vector<int> next(cell_start.begin(), cell_start.end() - 1);
+    for (int i = 0; i < n; ++i) grid_order[next[code[i]]++] = i;
+
+    grid_xs.resize(n);
+    grid_ys.resize(n);
+    for (int k = 0; k < n; ++k) {
+        grid_xs[k] = points[grid_order[k]].x;
+        grid_ys[k] = points[grid_order[k]].y;
+    }
+}
+
+void SpatialIndex::collect(const BoundingBox& box, int level, std::uint32_t cx, std::uint32_t cy,
+                           std::vector<int>& out) const {
+    const int shift = 2 * (depth - level);
+    const std::uint64_t code = morton_encode(cx, cy);
+    const int begin = cell_start[code << shift];
+    const int end = cell_start[(code + 1) << shift];
+    if (begin == end) return;
+
+    // Cell bounds, widened slightly: a point's cell index comes from a
+    // floating-point division and may sit a rounding error outside them
+    const double s = side / (1u << level);
+    const double tol = s * 1e-9;
+    const double x0 = min_x + cx * s - tol, x1 = min_x + (cx + 1) * s + tol;
+    const double y0 = min_y + cy * s - tol, y1 = min_y + (cy + 1) * s + tol;
+
+    if (x1 < box.min_x || x0 > box.max_x || y1 < box.min_y || y0 > box.max_y) return;
+
+    if (x0 >= box.min_x && x1 <= box.max_x && y0 >= box.min_y && y1 <= box.max_y) {
+        out.insert(out.end(), grid_order.begin() + begin, grid_order.begin() + end);
+        return;
+    }
+
+    if (level == depth) {
+        for (int k = begin; k < end; ++k) {
+            if (box.contains(grid_xs[k], grid_ys[k])) out.push_back(grid_order[k]);
+        }
+        return;
+    }
+
+    // Children in Morton order, so the output stays in Morton order
+    for (std::uint32_t child = 0; child < 4; ++child) {
+        collect(box, level + 1, 2 * cx + (child & 1), 2 * cy + (child >> 1), out);
+    }
+}
+
+std::vector<int> SpatialIndex::query_box(const BoundingBox& box) const {
+    std::vector<int> out;
+    if (!points.empty()) collect(box, 0, 0, 0, out);
+    return out;
+}
+
+ClosestPairResult SpatialIndex::solve_subset(std::vector<int>& subset) const {
+    ClosestPairResult result;
+    result.distance = std::numeric_limits<double>::infinity();
+    result.runtime_ms = 0;
+    result.comparisons = 0;
+
+    // Order by x rank; equal ranks are the same point (repeated ids)
+    std::vector<KeyIndex> keys(subset.size());
+    for (size_t k = 0; k < subset.size(); ++k) {
+        keys[k] = {x_rank[subset[k]], static_cast<std::uint32_t>(subset[k])};
+    }
+    sort_by_rank(keys);
+    keys.erase(std::unique(keys.begin(), keys.end(),
+        [](const KeyIndex& a, const KeyIndex& b) { return a.key == b.key; }), keys.end());
+
+    const size_t m = keys.size();
+    if (m < 2) return result;
+
+    std::vector<Point> ordered(m);
+    for (size_t k = 0; k < m; ++k) ordered[k] = sorted_x[keys[k].key];
+
+    ClosestPairEngine<Point> engine(m);
+    engine.solve(ordered.data(), m);
+
+    result.p1 = engine.best_a;
+    result.p2 = engine.best_b;
+    result.distance = std::sqrt(engine.best);
+    result.comparisons = engine.comparisons;
+    return result;
+}
+
+ClosestPairResult SpatialIndex::closest_pair_in_box(const BoundingBox& box) const {
+    Timer timer;
+    timer.start();
+
+    std::vector<int> subset = query_box(box);
+    ClosestPairResult result = solve_subset(subset);
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
+
+ClosestPairResult SpatialIndex::closest_pair_of_ids(const std::vector<int>& ids) const {
+    Timer timer;
+    timer.start();
+
+    std::vector<int> subset;
+    subset.reserve(ids.size());
+    for (int id : ids) {
+        auto it = id_to_index.find(id);
+        if (it != id_to_index.end()) subset.push_back(it->second);
+    }
+    ClosestPairResult result = solve_subset(subset);
+
+    timer.stop();
+    result.runtime_ms = timer.elapsed_ms();
+    return result;
+}
@@ -0,0 +1,105 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "../divide_conquer/closest_pair.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Axis-aligned query rectangle (inclusive bounds)
+ */
+struct BoundingBox {
+    double min_x, min_y, max_x, max_y;
+
+    bool contains(double x, double y) const {
+        return x >= min_x && x <= max_x && y >= min_y && y <= max_y;
+    }
+};
+
+/**
+ * @brief Index over a fixed point set for repeated closest-pair subset queries
+ *
+ * Real problem: "closest pair among users in this city / this cohort",
+ * asked many times over the same user base. divide_conquer_closest_pair
+ * copies and re-sorts the subset on every call.
+ *
+ * Built once:
+ * - Precomputed ranks: x_rank[i] is the position of point i in compare_x
+ *   order, and the full point set is kept in that order
+ * - Hierarchical grid: points are stored in Morton order of the finest
+ *   2^L × 2^L grid (about kLeafSize points per cell). Every coarser cell
+ *   is a quadtree node whose points form a contiguous run of that order,
+ *   so one offset array over the finest cells serves every level.
+ *
+ * Per query:
+ * 1. Collect the subset: walk the quadtree, taking whole runs for cells
+ *    inside the box and filtering only the cells crossing its boundary (or
+ *    map ids to points through a hash map)
+ * 2. Order the subset by x rank: integer keys < n, radix sorted in O(m)
+ *    for a subset of m points (no floating-point sort)
+ * 3. Run the allocation-free divide and conquer (ClosestPairEngine) on
+ *    that order; it produces the y order itself by merging on the way up
+ *
+ * Build Time: O(n) radix sort plus O(n + 4^L) grid construction
+ * Query Time: O(m log m + boundary cells) for m points in the subset,
+ *             independent of n
+ * Space Complexity: O(n)
+ */
+class SpatialIndex {
+public:
+    /**
+     * @brief Build the index (ids must be unique for id queries)
+     * @param points Input points (copied; indices refer to this vector)
+     */
+    explicit SpatialIndex(const std::vector<Point>& points);
+
+    /**
+     * @brief Closest pair among the points inside box
+     *
+     * runtime_ms covers the whole query (collection, ordering, recursion);
+     * distance is infinity if the box holds fewer than two points.
+     */
+    ClosestPairResult closest_pair_in_box(const BoundingBox& box) const;
+
+    /**
+     * @brief Closest pair among the points with the given ids
+     *
+     * Unknown ids are ignored and repeated ids count once.
+     */
+    ClosestPairResult closest_pair_of_ids(const std::vector<int>& ids) const;
+
+    /**
+     * @brief Input indices of the points inside box (in Morton order)
+     */
+    std::vector<int> query_box(const BoundingBox& box) const;
+
+    /**
+     * @brief Depth L of the hierarchical grid (finest level has 4^L cells)
+     */
+    int levels() const { return depth; }
+
+    int size() const { return static_cast<int>(points.size()); }
+
+private:
+    static const int kLeafSize = 8;     // Target points per finest cell
+    static const int kMaxDepth = 11;    // Caps the offset array at 4^11 + 1
+
+    std::vector<Point> points;          // Input points
+    std::vector<Point> sorted_x;        // All points in compare_x order
+    std::vector<std::uint32_t> x_rank;  // Position of each input point in sorted_x
+    std::unordered_map<int, int> id_to_index;
+
+    double min_x = 0, min_y = 0;        // Grid origin
+    double side = 1;                    // Side of the root cell
+    int depth = 0;                      // L
+    std::vector<int> grid_order;        // Input indices in finest-cell Morton order
+    std::vector<double> grid_xs, grid_ys;   // Coordinates in the same order
+    std::vector<int> cell_start;        // 4^L + 1 offsets into grid_order
+
+    void collect(const BoundingBox& box, int level, std::uint32_t cx, std::uint32_t cy,
+                 std::vector<int>& out) const;
+    ClosestPairResult solve_subset(std::vector<int>& subset) const;
+};
+
+#endif // SPATIAL_INDEX_H